@@ -1,14 +1,14 @@
 CrawlerSrc = $(BkRoot)src/blinkit
 CrawlerFlags = -I$(CrawlerSrc) -I$(BkRoot)src/stub/icu -DBLINKIT_CRAWLER_ONLY $(CrFlags) -include _pc.h
 CrawlerObjects = app_constants.o app_impl.o posix_app.o \
-	local_frame_client_impl.o posix_task_runner.o posix_thread.o thread_impl.o url_loader_impl.o \
+	cookie_jar_impl.o cookie_snapshot.o local_frame_client_impl.o posix_task_runner.o posix_thread.o thread_impl.o url_loader_impl.o \
 	bk_http_header_map.o bk_url.o \
-	crawler_document.o crawler_element.o crawler_impl.o crawler_script_element.o \
-	curl_request.o request_impl.o response_impl.o \
+	crawler_document.o crawler_element.o crawler_impl.o crawler_script_element.o load_policy.o \
+	curl_request.o disk_cache.o request_impl.o response_cache.o response_impl.o \
 	context_impl.o js_value_impl.o \
-	http_loader_task.o loader_task.o \
+	fetch_scheduler.o http_loader_task.o loader_task.o request_coalescer.o \
 	buffer.o controller.o \
-	task_loop.o
+	prefork_supervisor.o task_loop.o
 
 app_constants.o: $(CrawlerSrc)/app/app_constants.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
@@ -17,6 +17,10 @@ app_impl.o: $(CrawlerSrc)/app/app_impl.cpp
 posix_app.o: $(CrawlerSrc)/app/posix_app.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 
+cookie_jar_impl.o: $(CrawlerSrc)/blink_impl/cookie_jar_impl.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
+cookie_snapshot.o: $(CrawlerSrc)/blink_impl/cookie_snapshot.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 local_frame_client_impl.o: $(CrawlerSrc)/blink_impl/local_frame_client_impl.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 posix_task_runner.o: $(CrawlerSrc)/blink_impl/posix_task_runner.cpp
@@ -41,11 +45,17 @@ crawler_impl.o: $(CrawlerSrc)/crawler/crawler_impl.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 crawler_script_element.o: $(CrawlerSrc)/crawler/crawler_script_element.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
+load_policy.o: $(CrawlerSrc)/crawler/load_policy.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 
 curl_request.o: $(CrawlerSrc)/http/curl_request.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
+disk_cache.o: $(CrawlerSrc)/http/disk_cache.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 request_impl.o: $(CrawlerSrc)/http/request_impl.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
+response_cache.o: $(CrawlerSrc)/http/response_cache.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 response_impl.o: $(CrawlerSrc)/http/response_impl.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 
@@ -54,15 +64,21 @@ context_impl.o: $(CrawlerSrc)/js/context_impl.cpp
 js_value_impl.o: $(CrawlerSrc)/js/js_value_impl.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 
+fetch_scheduler.o: $(CrawlerSrc)/loader_tasks/fetch_scheduler.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 http_loader_task.o: $(CrawlerSrc)/loader_tasks/http_loader_task.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 loader_task.o: $(CrawlerSrc)/loader_tasks/loader_task.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
+request_coalescer.o: $(CrawlerSrc)/loader_tasks/request_coalescer.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 
 buffer.o: $(CrawlerSrc)/misc/buffer.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 controller.o: $(CrawlerSrc)/misc/controller.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 
+prefork_supervisor.o: $(CrawlerSrc)/posix/prefork_supervisor.cpp
+	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
 task_loop.o: $(CrawlerSrc)/posix/task_loop.cpp
 	$(CXX) -c $(CXXFLAGS) $(CrawlerFlags) $< -o $@
@@ -18,9 +18,18 @@
 #include <cstring>
 #include <string>
 #include <vector>
+#include "bk_app.h"
 #include "bk_crawler.h"
 #include "bk_http.h"
 
+#ifdef __cpp_impl_coroutine
+#   define BLINKIT_COROUTINES
+#   include <coroutine>
+#   include <exception>
+#   include <optional>
+#   include <utility>
+#endif
+
 namespace BlinKit {
 
 /*
@@ -139,6 +148,8 @@ protected:
         rawClient.RequestComplete = RequestCompleteImpl;
         rawClient.DocumentReady = DocumentReadyImpl;
         rawClient.Error = ErrorImpl;
+        rawClient.DocumentParsed = DocumentParsedImpl;
+        rawClient.DOMContentLoaded = DOMContentLoadedImpl;
     }
     virtual void RequestComplete(BkResponse response, BkWorkController controller)
     {
@@ -155,6 +166,10 @@ private:
     {
         assert(BK_ERR_SUCCESS == errorCode);
     }
+    // Return true to stop loading the rest of the page, DocumentReady is not called then, but LoadingStopped is.
+    virtual bool DocumentParsed(void) { return false; }
+    virtual bool DOMContentLoaded(void) { return false; }
+    virtual void LoadingStopped(void) {}
 
     static void BKAPI GetConfigImpl(int cfg, BkBuffer *dst, void *userData)
     {
@@ -174,8 +189,363 @@ private:
     {
         ToImpl(userData)->Error(errorCode, URL);
     }
+    static bool_t BKAPI DocumentParsedImpl(void *userData)
+    {
+        BkCrawlerClientImpl *This = ToImpl(userData);
+        if (!This->DocumentParsed())
+            return false;
+        This->LoadingStopped();
+        return true;
+    }
+    static bool_t BKAPI DOMContentLoadedImpl(void *userData)
+    {
+        BkCrawlerClientImpl *This = ToImpl(userData);
+        if (!This->DOMContentLoaded())
+            return false;
+        This->LoadingStopped();
+        return true;
+    }
+};
+
+#ifdef BLINKIT_COROUTINES
+
+/**
+ * BkExecutor
+ *   Resumes coroutines on the task queue of an engine thread.
+ */
+
+class BkExecutor
+{
+public:
+    explicit BkExecutor(BkTaskQueue queue = nullptr) : m_queue(queue) {}
+
+    // Null outside engine threads.
+    static BkExecutor Current(void) { return BkExecutor(BkGetCurrentTaskQueue()); }
+    bool IsValid(void) const { return nullptr != m_queue; }
+
+    // Never resumes the coroutine on the calling thread, which may be any thread. Returns false if it cannot be
+    // posted, then the coroutine is left suspended.
+    bool Post(std::coroutine_handle<> h) const
+    {
+        assert(nullptr != m_queue);
+        if (nullptr != m_queue && BkPostTask(m_queue, ResumeImpl, h.address()))
+            return true;
+        assert(false); // The engine thread is gone!
+        return false;
+    }
+
+    // co_await executor.Schedule() continues the coroutine on the executor's thread. Returns false, still on the
+    // current thread, if the executor is not valid or the task cannot be posted.
+    auto Schedule(void) const
+    {
+        struct Awaiter {
+            BkExecutor executor;
+            bool posted = false;
+            bool await_ready(void) const noexcept { return !executor.IsValid(); }
+            bool await_suspend(std::coroutine_handle<> h) { return posted = executor.Post(h); }
+            bool await_resume(void) const noexcept { return posted; }
+        };
+        return Awaiter{ *this };
+    }
+private:
+    static void BKAPI ResumeImpl(void *address)
+    {
+        std::coroutine_handle<>::from_address(address).resume();
+    }
+
+    BkTaskQueue m_queue;
+};
+
+/**
+ * BkTask
+ *   Lazily started coroutine, co_await it, or Detach it to run on its own.
+ */
+
+template <typename T = void>
+class BkTask;
+
+class BkPromiseBase
+{
+public:
+    struct FinalAwaiter {
+        bool await_ready(void) const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+        {
+            BkPromiseBase &promise = h.promise();
+            std::coroutine_handle<> continuation = promise.m_continuation;
+            if (promise.m_detached)
+            {
+                if (promise.m_exception)
+                    std::terminate();
+                h.destroy();
+            }
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume(void) const noexcept {}
+    };
+
+    std::suspend_always initial_suspend(void) noexcept { return {}; }
+    FinalAwaiter final_suspend(void) noexcept { return {}; }
+    void unhandled_exception(void) { m_exception = std::current_exception(); }
+
+    std::coroutine_handle<> m_continuation;
+    bool m_detached = false;
+protected:
+    void RethrowIfFailed(void)
+    {
+        if (m_exception)
+            std::rethrow_exception(m_exception);
+    }
+private:
+    std::exception_ptr m_exception;
+};
+
+template <typename T>
+class BkPromise : public BkPromiseBase
+{
+public:
+    BkTask<T> get_return_object(void);
+    void return_value(T value) { m_value.emplace(std::move(value)); }
+
+    T Result(void)
+    {
+        RethrowIfFailed();
+        return std::move(*m_value);
+    }
+private:
+    std::optional<T> m_value;
+};
+
+template <>
+class BkPromise<void> : public BkPromiseBase
+{
+public:
+    BkTask<void> get_return_object(void);
+    void return_void(void) {}
+
+    void Result(void) { RethrowIfFailed(); }
+};
+
+template <typename T>
+class BkTask
+{
+public:
+    using promise_type = BkPromise<T>;
+
+    explicit BkTask(std::coroutine_handle<promise_type> h) : m_handle(h) {}
+    BkTask(BkTask &&o) noexcept : m_handle(std::exchange(o.m_handle, nullptr)) {}
+    BkTask(const BkTask &) = delete;
+    ~BkTask(void)
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    // Starts the task without waiting for it, the coroutine frees itself when done.
+    void Detach(void)
+    {
+        std::coroutine_handle<promise_type> h = std::exchange(m_handle, nullptr);
+        h.promise().m_detached = true;
+        h.resume();
+    }
+
+    bool await_ready(void) const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+        m_handle.promise().m_continuation = caller;
+        return m_handle;
+    }
+    T await_resume(void) { return m_handle.promise().Result(); }
+private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template <typename T>
+inline BkTask<T> BkPromise<T>::get_return_object(void)
+{
+    return BkTask<T>(std::coroutine_handle<BkPromise<T>>::from_promise(*this));
+}
+
+inline BkTask<void> BkPromise<void>::get_return_object(void)
+{
+    return BkTask<void>(std::coroutine_handle<BkPromise<void>>::from_promise(*this));
+}
+
+/**
+ * BkCoCrawler
+ *   int err = co_await crawler.Run(URL);
+ *   Resumes on the calling engine thread, with BK_ERR_SUCCESS when the document is ready or the loading is stopped
+ *   by DocumentParsed/DOMContentLoaded, or the error code. Fails at once with BK_ERR_FORBIDDEN off engine threads.
+ */
+
+class BkCoCrawler : public BkCrawlerClientImpl
+{
+public:
+    BkCoCrawler(void) = default;
+    ~BkCoCrawler(void)
+    {
+        if (nullptr != m_crawler)
+            BkDestroyCrawler(m_crawler);
+    }
+
+    BkCrawler Get(void) const { return m_crawler; }
+
+    auto Run(const char *URL)
+    {
+        struct Awaiter {
+            BkCoCrawler &crawler;
+            const char *URL;
+            bool await_ready(void) const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> h) { return crawler.Start(URL, h); }
+            int await_resume(void) const noexcept { return crawler.m_result; }
+        };
+        return Awaiter{ *this, URL };
+    }
+private:
+    bool Start(const char *URL, std::coroutine_handle<> h)
+    {
+        if (nullptr == m_crawler)
+            m_crawler = BkCreateCrawler(*this);
+        if (nullptr == m_crawler)
+        {
+            m_result = BK_ERR_UNKNOWN;
+            return false;
+        }
+
+        // Resumed on this thread, which has to be an engine thread.
+        m_executor = BkExecutor::Current();
+        if (!m_executor.IsValid())
+        {
+            m_result = BK_ERR_FORBIDDEN;
+            return false;
+        }
+
+        m_waiter = h;
+        int err = BkRunCrawler(m_crawler, URL);
+        if (BK_ERR_SUCCESS == err || !m_waiter)
+            return true;
+
+        m_waiter = nullptr;
+        m_result = err;
+        return false;
+    }
+
+    // Resumed by a task, not inside the callback, so that the coroutine is free to destroy the crawler.
+    void Resume(int result)
+    {
+        m_result = result;
+        if (std::coroutine_handle<> h = std::exchange(m_waiter, nullptr))
+            m_executor.Post(h);
+    }
+
+    void DocumentReady(void) override { Resume(BK_ERR_SUCCESS); }
+    void LoadingStopped(void) override { Resume(BK_ERR_SUCCESS); }
+    void Error(int errorCode, const char *URL) override { Resume(errorCode); }
+
+    BkCrawler m_crawler = nullptr;
+    BkExecutor m_executor;
+    std::coroutine_handle<> m_waiter;
+    int m_result = BK_ERR_SUCCESS;
+};
+
+/**
+ * BkCoRequest
+ *   BkCoRequest request(URL);
+ *   const BkCoRequest::Result &result = co_await request.Perform();
+ *   Resumes on the calling engine thread once the response is complete or the request failed. A request performs
+ *   only once, and fails at once with BK_ERR_FORBIDDEN off engine threads.
+ */
+
+class BkCoRequest : public BkRequestClientImpl
+{
+public:
+    struct Result {
+        int ErrorCode = BK_ERR_SUCCESS;
+        int StatusCode = 0;
+        std::string URL;
+        std::string Body;
+    };
+
+    BkCoRequest(const char *URL)
+    {
+        m_request = BkCreateRequest(URL, *this);
+    }
+    BkCoRequest(const BkCoRequest &) = delete;
+    ~BkCoRequest(void)
+    {
+        // Never performed, otherwise the request has released itself.
+        if (nullptr != m_request)
+            BkReleaseRequest(m_request);
+    }
+
+    // For setting up the method, headers & so on, before Perform.
+    BkRequest Get(void) const { return m_request; }
+
+    auto Perform(void)
+    {
+        struct Awaiter {
+            BkCoRequest &request;
+            bool await_ready(void) const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> h) { return request.Start(h); }
+            const Result& await_resume(void) const noexcept { return request.m_result; }
+        };
+        return Awaiter{ *this };
+    }
+private:
+    bool Start(std::coroutine_handle<> h)
+    {
+        if (nullptr == m_request)
+        {
+            m_result.ErrorCode = BK_ERR_UNKNOWN;
+            return false;
+        }
+
+        // Resumed on this thread, which has to be an engine thread.
+        m_executor = BkExecutor::Current();
+        if (!m_executor.IsValid())
+        {
+            m_result.ErrorCode = BK_ERR_FORBIDDEN;
+            return false;
+        }
+
+        m_waiter = h;
+
+        // The request releases itself once done, or at once if it fails to start.
+        BkRequest request = std::exchange(m_request, nullptr);
+        int err = BkPerformRequest(request, nullptr);
+        if (BK_ERR_SUCCESS == err)
+            return true;
+
+        m_waiter = nullptr;
+        m_result.ErrorCode = err;
+        return false;
+    }
+
+    // Called on the HTTP thread, |this| must not be touched after posting.
+    void Resume(void) { m_executor.Post(m_waiter); }
+
+    void RequestComplete(BkResponse response) override
+    {
+        m_result.StatusCode = BkGetResponseStatusCode(response);
+        BkGetResponseData(response, BK_RE_CURRENT_URL, BkMakeBuffer(m_result.URL));
+        BkGetResponseData(response, BK_RE_BODY, BkMakeBuffer(m_result.Body));
+        Resume();
+    }
+    void RequestFailed(int errorCode) override
+    {
+        m_result.ErrorCode = errorCode;
+        Resume();
+    }
+
+    BkRequest m_request = nullptr;
+    BkExecutor m_executor;
+    std::coroutine_handle<> m_waiter;
+    Result m_result;
 };
 
+#endif // BLINKIT_COROUTINES
+
 } // namespace BlinKit
 
 #endif // BLINKIT_SDK_BLINKIT_HPP
@@ -15,19 +15,23 @@
 
 #include "bk_def.h"
 
+BK_DECLARE_HANDLE(BkTaskQueue, TaskQueueImpl);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 enum BkAppMode {
     BK_APP_MAINTHREAD_MODE = 0,
-    BK_APP_BACKGROUND_MODE
+    BK_APP_BACKGROUND_MODE,
+    BK_APP_POOL_MODE // Several background threads, each running its own engine. POSIX only for now.
 };
 
 struct BkAppClient {
     size_t SizeOfStruct; // sizeof(BkAppClient)
     void *UserData;
     void (BKAPI * Exit)(void *);
+    unsigned PoolSize; // Pool mode only, the number of engine threads, 0 for the number of CPU cores.
 };
 
 BKEXPORT bool_t BKAPI BkInitialize(int mode, struct BkAppClient *client);
@@ -35,7 +39,7 @@ BKEXPORT bool_t BKAPI BkInitialize(int mode, struct BkAppClient *client);
 /**
  * If you have your own message loops, call BkFinalize before application exiting.
  *   Cannot be used with BkRunApp.
- *   Mainthread mode only.
+ *   Mainthread & pool mode only.
  */
 BKEXPORT void BKAPI BkFinalize(void);
 
@@ -48,15 +52,67 @@ BKEXPORT int BKAPI BkRunApp(void);
 
 /**
  * BkExitApp exits the message loop which created by BkRunApp or in backgound mode.
+ *   In background mode, it waits for the background thread to finish, unless called from that thread.
+ *   In pool mode, it stops all the engine threads, just like BkFinalize. If called from an engine thread, it returns
+ *   at once and the engines are stopped on another thread, once the current task is done.
  */
 BKEXPORT void BKAPI BkExitApp(int code);
 
 /**
  * Execute code in the backgound thread.
+ *   In pool mode, the code runs on the least loaded engine thread, crawlers created there stay on that thread,
+ *   and so do their callbacks.
  */
 typedef void (BKAPI * BkBackgroundWorker)(void *);
 BKEXPORT bool_t BKAPI BkAppExecute(BkBackgroundWorker worker, void *userData);
 
+/**
+ * The task queue of the calling engine thread (the main/background thread, or an engine thread of the pool).
+ *   BkPostTask runs the worker on that thread later, and can be called from any thread, e.g. from HTTP callbacks.
+ */
+BKEXPORT BkTaskQueue BKAPI BkGetCurrentTaskQueue(void);
+BKEXPORT bool_t BKAPI BkPostTask(BkTaskQueue queue, BkBackgroundWorker worker, void *userData);
+
+#ifdef __linux__
+/**
+ * For hosts having their own poll loops, instead of BkRunApp.
+ *   BkGetTaskFd returns a descriptor which is readable while BlinKit has tasks ready, add it to the poll set.
+ *   BkPumpTasks runs the ready tasks until the budget is used up, and returns true if some tasks are left.
+ *   Mainthread mode only, in other modes they return -1 and false. Call BkFinalize before application exiting.
+ */
+BKEXPORT int BKAPI BkGetTaskFd(void);
+BKEXPORT bool_t BKAPI BkPumpTasks(unsigned budgetInUs);
+
+/**
+ * Prefork workers, which share the initialized engine (and whatever warmed up before) copy-on-write.
+ *   Call BkRunPreforkWorkers from the main thread in mainthread mode, while nothing is loading. It forks the
+ *   workers, each of them runs WorkerMain (creating crawlers, then BkRunApp or BkFinalize) and exits with its
+ *   return value. The parent waits for the workers, restarts the ones killed by a signal, and returns when all
+ *   of them are gone.
+ *   BkStopPreforkWorkers (from another thread of the parent) sends SIGTERM to the workers and stops restarting.
+ */
+struct BkWorkerStats {
+    size_t SizeOfStruct; // sizeof(BkWorkerStats)
+    unsigned Index;
+    int Pid;             // 0 if not running.
+    unsigned Restarts;
+    int LastStatus;      // As returned by waitpid.
+};
+
+struct BkPreforkClient {
+    size_t SizeOfStruct; // sizeof(BkPreforkClient)
+    void *UserData;
+    unsigned Workers;     // 0 for the number of CPU cores.
+    unsigned MaxRestarts; // Per worker, 0 for no limit.
+    int (BKAPI * WorkerMain)(unsigned index, void *userData);
+    void (BKAPI * WorkerExited)(const struct BkWorkerStats *stats, void *userData); // In the parent.
+};
+
+BKEXPORT int BKAPI BkRunPreforkWorkers(struct BkPreforkClient *client);
+BKEXPORT void BKAPI BkStopPreforkWorkers(void);
+BKEXPORT unsigned BKAPI BkGetWorkerStats(struct BkWorkerStats *stats, unsigned count);
+#endif
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
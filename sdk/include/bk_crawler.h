@@ -24,7 +24,25 @@ BK_DECLARE_HANDLE(BkCrawler, CrawlerImpl);
 enum BkCrawlerConfig {
     BK_CFG_OBJECT_SCRIPT = 0,
     BK_CFG_USER_AGENT,
-    BK_CFG_SCRIPT_DISABLED
+    BK_CFG_SCRIPT_DISABLED,
+    BK_CFG_PRELOAD_LIMIT,
+    // Which subresources to fetch, read once per BkRunCrawler. Rules are separated by ';' or line breaks, tried in
+    // order and the first match wins, loads matching no rule are allowed. Each rule looks like:
+    //     allow|deny type:<types>  (document, script, stylesheet, image, font, media, xhr, prefetch, manifest)
+    //     allow|deny mime:<types>  (guessed by the extension, e.g. image/*)
+    //     allow|deny url:<globs>   (e.g. *://*.doubleclick.net/*)
+    // Lists are separated by ',', '*' matches anything. Denied loads fail with BK_ERR_FORBIDDEN without touching the
+    // network, so the parser goes on as if the resource were unavailable. For example:
+    //     deny type:image,font,media; allow url:https://example.com/*; deny mime:text/css
+    BK_CFG_LOAD_POLICY,
+    // Limits of a crawl, read once per BkRunCrawler, empty or 0 for none: the wall time in milliseconds, the number of
+    // subresources requested, and the bytes received in total (the document included). Once one is reached, the crawl
+    // is truncated: transfers in flight are aborted and fail with BK_ERR_CANCELLED, further loads are denied, and the
+    // page is completed with what it has got, so DocumentReady follows as usual, in which BkIsCrawlTruncated tells.
+    // If the document itself has not arrived by then, Error is called with BK_ERR_CANCELLED instead.
+    BK_CFG_TIME_LIMIT,
+    BK_CFG_SUBRESOURCE_LIMIT,
+    BK_CFG_BYTE_LIMIT
 };
 
 struct BkCrawlerClient {
@@ -38,15 +56,105 @@ struct BkCrawlerClient {
     void (BKAPI * DocumentReady)(void *);
     void (BKAPI * Error)(int, const char *, void *);
     void (BKAPI * ConsoleMessage)(int type, const char *, void *);
+    // Early points of the page, for extracting from the static HTML. DocumentParsed is called once the whole HTML is
+    // parsed, before the deferred scripts run, and DOMContentLoaded right after that event. Scripts cannot be run
+    // from inside. Return true to stop loading the rest of the page, then neither DocumentReady nor Error follows.
+    bool_t (BKAPI * DocumentParsed)(void *);
+    bool_t (BKAPI * DOMContentLoaded)(void *);
 };
 
 BKEXPORT BkCrawler BKAPI BkCreateCrawler(struct BkCrawlerClient *client);
 BKEXPORT void BKAPI BkDestroyCrawler(BkCrawler crawler);
 
+// A crawler can be run again for the next page, which is much cheaper than a new one: the frame and the script heap
+// are reused, while the previous page's loads, document and globals are dropped. BkResetCrawler does the dropping
+// part at once, e.g. to release a finished page before the crawler idles.
 BKEXPORT int BKAPI BkRunCrawler(BkCrawler crawler, const char *URL);
+BKEXPORT void BKAPI BkResetCrawler(BkCrawler crawler);
+// Whether the current crawl was cut by a limit, see BK_CFG_TIME_LIMIT.
+BKEXPORT bool_t BKAPI BkIsCrawlTruncated(BkCrawler crawler);
+
+// The transfers made by the current crawl, summed up, see BkResponseTiming. Divide by Transfers for averages.
+// Responses served by the caches or by a transfer of another crawler are not counted.
+struct BkCrawlTiming {
+    size_t SizeOfStruct; // sizeof(BkCrawlTiming)
+    size_t Transfers, ReusedConnections;
+    double NameLookup, Connect, TLSHandshake, FirstByte, Total;
+    size_t RequestBytes, HeaderBytes, BodyBytes;
+};
+BKEXPORT void BKAPI BkGetCrawlTiming(BkCrawler crawler, struct BkCrawlTiming *timing);
 
 BKEXPORT BkJSContext BKAPI BkGetScriptContextFromCrawler(BkCrawler crawler);
 
+enum BkExtractType {
+    BK_EXTRACT_OUTER_HTML = 0,
+    BK_EXTRACT_INNER_HTML,
+    BK_EXTRACT_TEXT,
+    BK_EXTRACT_ATTRIBUTE,
+    BK_EXTRACT_VISIBLE_TEXT
+};
+
+struct BkExtractField {
+    int Type;                   // BkExtractType
+    const char *AttributeName;  // BK_EXTRACT_ATTRIBUTE only
+};
+
+// Runs the selector against the document, and writes the fields of each match into |dst|, one after another, each
+// one terminated by '\0'. Missing attributes are written as empty strings. Fails with BK_ERR_RANGE if an argument is
+// null, or a field is invalid (an unknown type, or an attribute field without a name).
+BKEXPORT int BKAPI BkExtractElements(BkCrawler crawler, const char *selector, const struct BkExtractField *fields,
+    unsigned fieldCount, struct BkBuffer *dst);
+
+// Runs all the selectors in one pass over the document, results[i] receives the outer HTML of the elements
+// matched by selectors[i], each one terminated by '\0'. Fails with BK_ERR_RANGE if a selector or a buffer is null.
+BKEXPORT int BKAPI BkQuerySelectorsAll(BkCrawler crawler, const char *const *selectors, unsigned count,
+    struct BkBuffer *const *results);
+
+// Serializes the whole document as UTF-8 HTML, typically called in DocumentReady.
+BKEXPORT int BKAPI BkSerializeDocument(BkCrawler crawler, struct BkBuffer *dst);
+
+// Same as BkSerializeDocument, but the HTML is handed to |writer| chunk by chunk, without holding the whole
+// document in memory.
+typedef void (BKAPI * BkDataWriter)(const void *data, size_t size, void *userData);
+BKEXPORT int BKAPI BkWriteDocument(BkCrawler crawler, BkDataWriter writer, void *userData);
+
+// Writes the readable text of the document body into |dst| as UTF-8: contents of script, style and other non-content
+// elements are skipped, white spaces are collapsed, and block level elements are separated by line breaks.
+BKEXPORT int BKAPI BkGetVisibleText(BkCrawler crawler, struct BkBuffer *dst);
+
+// Restores the cookie jar from the snapshot file if it exists, the cookies of each domain are loaded on first use.
+// The jar is written back to the file every |flushInterval| seconds (0 for never), and on exit.
+BKEXPORT int BKAPI BkSetCookieSnapshot(const char *fileName, unsigned flushInterval);
+BKEXPORT int BKAPI BkFlushCookieSnapshot(void);
+
+// The process-wide memory cache of scripts and other subresources, which is shared by all the crawlers. Responses are
+// kept as long as their Cache-Control s-maxage or max-age allows, main documents and hijacked responses are never
+// cached. Private responses are not cached, nor are responses to requests with cookies or credentials, unless they
+// are public.
+struct BkResourceCacheStats {
+    size_t SizeOfStruct; // sizeof(BkResourceCacheStats)
+    size_t Hits, Misses, Evictions;
+    size_t Entries, Bytes;
+};
+BKEXPORT void BKAPI BkSetResourceCacheCapacity(size_t capacity);
+BKEXPORT void BKAPI BkGetResourceCacheStats(struct BkResourceCacheStats *stats);
+
+// Enables the HTTP cache on disk, which may be shared by several processes. Fresh responses are reused without
+// touching the network, stale ones are revalidated with If-None-Match / If-Modified-Since. Call it before crawling.
+BKEXPORT int BKAPI BkSetDiskCacheDirectory(const char *path);
+
+// Identical subresource requests (same URL and cookies) issued by crawlers at the same time share one transfer.
+struct BkCoalescingStats {
+    size_t SizeOfStruct; // sizeof(BkCoalescingStats)
+    size_t Transfers;    // Requests which went to the network.
+    size_t Coalesced;    // Requests which waited for an identical one instead.
+};
+BKEXPORT void BKAPI BkGetCoalescingStats(struct BkCoalescingStats *stats);
+
+// Caps the transfers in flight, in total and per host (0 for no limit), 32 and 6 by default. Requests over the caps
+// are queued and started by priority: documents first, then parser blocking scripts, then the others.
+BKEXPORT void BKAPI BkSetFetchLimits(unsigned total, unsigned perHost);
+
 BKEXPORT void BKAPI BkHijackResponse(BkResponse response, const void *newBody, size_t length);
 
 #ifdef __cplusplus
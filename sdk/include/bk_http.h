@@ -32,6 +32,8 @@ struct BkRequestClient {
 BKEXPORT BkRequest BKAPI BkCreateRequest(const char *URL, struct BkRequestClient *client);
 
 BKEXPORT int BKAPI BkPerformRequest(BkRequest request, BkWorkController *controller);
+// For requests which are never performed, a performed request releases itself once done.
+BKEXPORT void BKAPI BkReleaseRequest(BkRequest request);
 
 BKEXPORT void BKAPI BkSetRequestMethod(BkRequest request, const char *method);
 BKEXPORT void BKAPI BkSetRequestHeader(BkRequest request, const char *name, const char *value);
@@ -54,6 +56,34 @@ BKEXPORT int BKAPI BkGetResponseHeader(BkResponse response, const char *name, st
 BKEXPORT size_t BKAPI BkGetResponseCookiesCount(BkResponse response);
 BKEXPORT int BKAPI BkGetResponseCookie(BkResponse response, size_t index, struct BkBuffer *dst);
 
+// Borrowed views into the response, nothing is copied. They are valid as long as the response is, which is for the
+// callback it is passed to (in a crawler, until the work is continued or cancelled), or until BkReleaseResponse if it
+// is retained by BkRetainResponse. BkHijackResponse invalidates the body. Strings are not terminated by '\0'.
+BKEXPORT const void* BKAPI BkBorrowResponseBody(BkResponse response, size_t *size);
+// Returns NULL if there is no such header or cookie.
+BKEXPORT const char* BKAPI BkBorrowResponseHeader(BkResponse response, const char *name, size_t *length);
+BKEXPORT const char* BKAPI BkBorrowResponseCookie(BkResponse response, size_t index, size_t *length);
+// Visits all the headers in no particular order, until the visitor returns false.
+typedef bool_t (BKAPI * BkHeaderVisitor)(const char *name, size_t nameLength, const char *value, size_t valueLength,
+    void *userData);
+BKEXPORT void BKAPI BkVisitResponseHeaders(BkResponse response, BkHeaderVisitor visitor, void *userData);
+
+BKEXPORT BkResponse BKAPI BkRetainResponse(BkResponse response);
+BKEXPORT void BKAPI BkReleaseResponse(BkResponse response);
+
+// Where the time of the transfer went, as measured by the transport. Times are in milliseconds since the transfer
+// started, each one including the phases before it, so FirstByte - Connect is the time spent on the request itself.
+// Phases not gone through read 0, e.g. NameLookup & Connect on a reused connection, TLSHandshake for plain HTTP.
+// Everything is 0 for responses which did not come from the network, like cached ones.
+struct BkResponseTiming {
+    size_t SizeOfStruct; // sizeof(BkResponseTiming)
+    double NameLookup, Connect, TLSHandshake, FirstByte, Total;
+    size_t RequestBytes, HeaderBytes, BodyBytes; // Body bytes as transferred, i.e. before decoding.
+    bool_t ConnectionReused;
+    int HTTPVersion; // 10, 11, 20, 30, or 0 if unknown
+};
+BKEXPORT void BKAPI BkGetResponseTiming(BkResponse response, struct BkResponseTiming *timing);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
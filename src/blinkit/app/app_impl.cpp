@@ -13,19 +13,28 @@
 
 #include "base/single_thread_task_runner.h"
 #include "blinkit/app/app_constants.h"
+#include "blinkit/blink_impl/cookie_jar_impl.h"
 #include "blinkit/blink_impl/url_loader_impl.h"
+#include "blinkit/http/disk_cache.h"
+#include "blinkit/http/response_cache.h"
+#include "blinkit/loader_tasks/fetch_scheduler.h"
+#include "blinkit/loader_tasks/request_coalescer.h"
 #include "third_party/blink/public/platform/web_thread_scheduler.h"
 #include "third_party/blink/public/web/blink.h"
 
 #if 0 // BKTODO:
-#include "blink_impl/cookie_jar_impl.h"
 #include "blink_impl/mime_registry_impl.h"
 #include "crawler/crawler_impl.h"
 #endif
 
 namespace BlinKit {
 
-AppImpl::AppImpl(int mode, BkAppClient *client) : m_mode(mode)
+AppImpl::AppImpl(int mode, BkAppClient *client)
+    : m_mode(mode)
+    , m_cookieJar(std::make_unique<CookieJarImpl>())
+    , m_responseCache(std::make_unique<ResponseCache>())
+    , m_requestCoalescer(std::make_unique<RequestCoalescer>())
+    , m_fetchScheduler(std::make_unique<FetchScheduler>())
 {
     memset(&m_client, 0, sizeof(BkAppClient));
     if (nullptr != client)
@@ -42,39 +51,41 @@ AppImpl::AppImpl(int mode, BkAppClient *client) : m_mode(mode)
 
 AppImpl::~AppImpl(void)
 {
+    if (!m_cookieSnapshot.empty())
+        FlushCookieSnapshot();
     if (nullptr != m_client.Exit)
         m_client.Exit(m_client.UserData);
 }
 
-std::unique_ptr<blink::WebURLLoader> AppImpl::CreateURLLoader(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner)
+bool AppImpl::Dispatch(const std::function<void()> &task)
 {
-    return std::make_unique<URLLoaderImpl>(taskRunner);
+    return GetTaskRunner()->PostTask(FROM_HERE, task);
 }
 
-#if 0 // BKTODO:
-blink::WebURLError AppImpl::cancelledError(const blink::WebURL &url) const
+std::unique_ptr<blink::WebURLLoader> AppImpl::CreateURLLoader(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner)
 {
-    blink::WebURLError ret;
-    ret.reason = BkError::Cancelled;
-    ret.isCancellation = true;
-    return ret;
+    return std::make_unique<URLLoaderImpl>(taskRunner);
 }
 
-CookieJarImpl& AppImpl::CookieJar(void)
+int AppImpl::FlushCookieSnapshot(void)
 {
-    if (!m_cookieJar)
+    if (m_cookieSnapshot.empty())
+        return BK_ERR_NOT_FOUND;
+    if (!m_cookieJar->SaveSnapshot(m_cookieSnapshot))
     {
-        AutoLock lock(m_lock);
-        if (!m_cookieJar)
-            m_cookieJar = std::make_unique<CookieJarImpl>();
+        BKLOG("Save cookie snapshot failed: %s", m_cookieSnapshot.c_str());
+        return BK_ERR_UNKNOWN;
     }
-    return *m_cookieJar;
+    return BK_ERR_SUCCESS;
 }
 
-blink::WebCookieJar* AppImpl::cookieJar(void)
+#if 0 // BKTODO:
+blink::WebURLError AppImpl::cancelledError(const blink::WebURL &url) const
 {
-    CookieJarImpl &cookieJar = CookieJar();
-    return &cookieJar;
+    blink::WebURLError ret;
+    ret.reason = BkError::Cancelled;
+    ret.isCancellation = true;
+    return ret;
 }
 
 blink::WebThread* AppImpl::createThread(const char *name)
@@ -127,6 +138,40 @@ void AppImpl::Initialize(BkAppClient *client)
     blink::Initialize(this, m_mainThreadScheduler.get());
 }
 
+void AppImpl::ScheduleCookieSnapshotFlush(void)
+{
+    if (0 == m_cookieFlushInterval)
+        return;
+
+    const auto task = [this]
+    {
+        FlushCookieSnapshot();
+        ScheduleCookieSnapshotFlush();
+    };
+    GetTaskRunner()->PostDelayedTask(FROM_HERE, task, base::TimeDelta::FromSeconds(m_cookieFlushInterval));
+}
+
+void AppImpl::SetCookieSnapshot(const std::string &fileName, unsigned flushInterval)
+{
+    // A missing file is expected on the first run.
+    m_cookieJar->LoadSnapshot(fileName);
+
+    const bool scheduled = 0 != m_cookieFlushInterval;
+    m_cookieSnapshot = fileName;
+    m_cookieFlushInterval = flushInterval;
+    if (!scheduled)
+        ScheduleCookieSnapshotFlush();
+}
+
+int AppImpl::SetDiskCache(std::unique_ptr<DiskCache> diskCache)
+{
+    if (!diskCache)
+        return BK_ERR_UNKNOWN;
+    // Expected to be set up before any crawling, loader tasks use it without locking.
+    m_diskCache = std::move(diskCache);
+    return BK_ERR_SUCCESS;
+}
+
 #if 0 // BKTODO:
 blink::WebThread& AppImpl::IOThread(void)
 {
@@ -177,13 +222,13 @@ BKEXPORT bool_t BKAPI BkAppExecute(BkBackgroundWorker worker, void *userData)
     switch (app.Mode())
     {
         case BK_APP_BACKGROUND_MODE:
+        case BK_APP_POOL_MODE:
         {
             const auto task = [worker, userData]
             {
                 worker(userData);
             };
-            app.GetTaskRunner()->PostTask(FROM_HERE, task);
-            return true;
+            return app.Dispatch(task);
         }
 
         default:
@@ -199,6 +244,7 @@ BKEXPORT void BKAPI BkExitApp(int code)
     {
         case BK_APP_MAINTHREAD_MODE:
         case BK_APP_BACKGROUND_MODE:
+        case BK_APP_POOL_MODE:
             app.Exit(code);
             break;
         default:
@@ -218,11 +264,24 @@ BKEXPORT void BKAPI BkFinalize(void)
         case BK_APP_MAINTHREAD_MODE:
             delete app;
             break;
+        case BK_APP_POOL_MODE:
+            app->Exit(EXIT_SUCCESS);
+            break;
         default:
             NOTREACHED();
     }
 }
 
+BKEXPORT BkTaskQueue BKAPI BkGetCurrentTaskQueue(void)
+{
+    return reinterpret_cast<BkTaskQueue>(ThreadImpl::Current());
+}
+
+BKEXPORT int BKAPI BkFlushCookieSnapshot(void)
+{
+    return AppImpl::Get().FlushCookieSnapshot();
+}
+
 BKEXPORT bool_t BKAPI BkInitialize(int mode, BkAppClient *client)
 {
     if (nullptr != Platform::Current())
@@ -245,7 +304,11 @@ BKEXPORT bool_t BKAPI BkInitialize(int mode, BkAppClient *client)
         case BK_APP_BACKGROUND_MODE:
         {
             AppImpl::InitializeBackgroundInstance(client);
-            break;
+            return nullptr != Platform::Current();
+        }
+        case BK_APP_POOL_MODE:
+        {
+            return AppImpl::InitializePoolInstance(client);
         }
 
         default:
@@ -255,6 +318,19 @@ BKEXPORT bool_t BKAPI BkInitialize(int mode, BkAppClient *client)
     return true;
 }
 
+BKEXPORT bool_t BKAPI BkPostTask(BkTaskQueue queue, BkBackgroundWorker worker, void *userData)
+{
+    ThreadImpl *thread = reinterpret_cast<ThreadImpl *>(queue);
+    if (nullptr == thread)
+        return false;
+
+    const auto task = [worker, userData]
+    {
+        worker(userData);
+    };
+    return thread->GetTaskRunner()->PostTask(FROM_HERE, task);
+}
+
 BKEXPORT int BKAPI BkRunApp(void)
 {
     AppImpl &app = AppImpl::Get();
@@ -268,4 +344,13 @@ BKEXPORT int BKAPI BkRunApp(void)
     return EXIT_FAILURE;
 }
 
+BKEXPORT int BKAPI BkSetCookieSnapshot(const char *fileName, unsigned flushInterval)
+{
+    if (nullptr == fileName || '\0' == *fileName)
+        return BK_ERR_FORBIDDEN;
+
+    AppImpl::Get().SetCookieSnapshot(fileName, flushInterval);
+    return BK_ERR_SUCCESS;
+}
+
 } // extern "C"
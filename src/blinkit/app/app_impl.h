@@ -21,7 +21,11 @@
 namespace BlinKit {
 
 class CookieJarImpl;
+class DiskCache;
+class FetchScheduler;
 class MimeRegistryImpl;
+class RequestCoalescer;
+class ResponseCache;
 
 class AppImpl : public blink::Platform, public ThreadImpl
 {
@@ -30,29 +34,42 @@ public:
     virtual ~AppImpl(void);
 
     static void InitializeBackgroundInstance(BkAppClient *client);
+    static bool InitializePoolInstance(BkAppClient *client);
 
     static AppImpl& Get(void);
     int Mode(void) const { return m_mode; }
     virtual void Initialize(BkAppClient *client);
     virtual int RunAndFinalize(void) = 0;
     virtual void Exit(int code) = 0;
+    // Runs the task for BkAppExecute.
+    virtual bool Dispatch(const std::function<void()> &task);
 
+    CookieJarImpl& CookieJar(void) { return *m_cookieJar; }
+    void SetCookieSnapshot(const std::string &fileName, unsigned flushInterval);
+    int FlushCookieSnapshot(void);
+    ResponseCache& GetResponseCache(void) { return *m_responseCache; }
+    DiskCache* GetDiskCache(void) const { return m_diskCache.get(); }
+    RequestCoalescer& GetRequestCoalescer(void) { return *m_requestCoalescer; }
+    FetchScheduler& GetFetchScheduler(void) { return *m_fetchScheduler; }
+    int SetDiskCache(std::unique_ptr<DiskCache> diskCache);
 #if 0 // BKTODO:
     ThreadImpl* CurrentThreadImpl(void);
     blink::WebThread& IOThread(void);
-    CookieJarImpl& CookieJar(void);
 #endif
 
     void Log(const char *s);
 
 #if 0 // BKTODO:
     // blink::Platform
-    blink::WebCookieJar* cookieJar(void) final;
     blink::WebThread* currentThread(void) final;
 #endif
 protected:
     AppImpl(int mode, BkAppClient *client);
+
+    const BkAppClient& Client(void) const { return m_client; }
 private:
+    void ScheduleCookieSnapshotFlush(void);
+
     // blink::Platform
     std::unique_ptr<blink::WebURLLoader> CreateURLLoader(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner) final;
 #if 0 // BKTODO:
@@ -63,7 +80,6 @@ private:
     double currentTimeSeconds(void) final;
     double monotonicallyIncreasingTimeSeconds(void) final;
 
-    std::unique_ptr<CookieJarImpl> m_cookieJar;
     std::unique_ptr<MimeRegistryImpl> m_mimeRegistry;
     std::unique_ptr<blink::WebThread> m_IOThread;
     double m_firstMonotonicallyIncreasingTime;
@@ -71,6 +87,13 @@ private:
 #endif
     const int m_mode;
     BkAppClient m_client;
+    std::unique_ptr<CookieJarImpl> m_cookieJar;
+    std::string m_cookieSnapshot;
+    unsigned m_cookieFlushInterval = 0;
+    std::unique_ptr<ResponseCache> m_responseCache;
+    std::unique_ptr<DiskCache> m_diskCache;
+    std::unique_ptr<RequestCoalescer> m_requestCoalescer;
+    std::unique_ptr<FetchScheduler> m_fetchScheduler;
     std::unique_ptr<blink::scheduler::WebThreadScheduler> m_mainThreadScheduler;
 };
 
@@ -66,6 +66,12 @@ void AppImpl::InitializeBackgroundInstance(BkAppClient *client)
     ASSERT(false); // BKTODO:
 }
 
+bool AppImpl::InitializePoolInstance(BkAppClient *client)
+{
+    BKLOG("The pool mode is not supported on this platform yet.");
+    return false;
+}
+
 void AppImpl::Log(const char *s)
 {
     CF::StaticString ss(s);
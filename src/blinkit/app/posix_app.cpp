@@ -11,27 +11,172 @@
 
 #include "posix_app.h"
 
+#include <unistd.h>
 #include "blinkit/blink_impl/posix_task_runner.h"
+#include "blinkit/blink_impl/posix_thread.h"
 #include "blinkit/posix/task_loop.h"
+#include "third_party/blink/renderer/core/html/parser/html_parser_thread.h"
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
 
 namespace BlinKit {
 
+struct BackgroundThreadData
+{
+    BackgroundThreadData(void)
+    {
+        pthread_mutex_init(&mutex, nullptr);
+        pthread_cond_init(&cond, nullptr);
+    }
+    ~BackgroundThreadData(void)
+    {
+        pthread_cond_destroy(&cond);
+        pthread_mutex_destroy(&mutex);
+    }
+
+    void Signal(void)
+    {
+        pthread_mutex_lock(&mutex);
+        ready = true;
+        pthread_cond_signal(&cond);
+        pthread_mutex_unlock(&mutex);
+    }
+    void Wait(void)
+    {
+        pthread_mutex_lock(&mutex);
+        while (!ready)
+            pthread_cond_wait(&cond, &mutex);
+        pthread_mutex_unlock(&mutex);
+    }
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool ready = false;
+    BkAppClient *client = nullptr;
+};
+
 PosixApp::PosixApp(int mode, BkAppClient *client) : AppImpl(mode, client), m_taskLoop(std::make_unique<TaskLoop>())
 {
 }
 
 PosixApp::~PosixApp(void) = default;
 
+void* PosixApp::BackgroundThread(void *arg)
+{
+    BackgroundThreadData *data = reinterpret_cast<BackgroundThreadData *>(arg);
+
+    PosixApp *app = new PosixApp(BK_APP_BACKGROUND_MODE, data->client);
+    app->m_backgroundThread = pthread_self();
+    app->Initialize(nullptr);
+    data->Signal();
+
+    return reinterpret_cast<void *>(static_cast<intptr_t>(app->RunAndFinalize()));
+}
+
+PosixApp& PosixApp::Get(void)
+{
+    return static_cast<PosixApp &>(AppImpl::Get());
+}
+
+bool PosixApp::Dispatch(const std::function<void()> &task)
+{
+    if (m_engines.empty())
+        return AppImpl::Dispatch(task);
+
+    PosixThread *engine = m_engines.front().get();
+    for (const auto &it : m_engines)
+    {
+        if (it->Load() < engine->Load())
+            engine = it.get();
+    }
+
+    // Counted until the task is done, so that a burst of tasks is spread over the engines.
+    engine->IncreaseLoad();
+    const auto wrapper = [engine, task]
+    {
+        task();
+        engine->DecreaseLoad();
+    };
+    return engine->GetTaskRunner()->PostTask(FROM_HERE, wrapper);
+}
+
 void PosixApp::Exit(int code)
 {
+    if (BK_APP_POOL_MODE == Mode())
+    {
+        // The engines are joined on deletion, which cannot be done by one of them.
+        if (!IsEngineThread())
+        {
+            delete this;
+            return;
+        }
+
+        pthread_t thread;
+        if (0 == pthread_create(&thread, nullptr, ShutdownThread, this))
+            pthread_detach(thread);
+        else
+            BKLOG("Failed to start the shutdown thread.");
+        return;
+    }
+
+    if (!m_backgroundThread.has_value())
+    {
+        m_taskLoop->Exit(code);
+        return;
+    }
+
+    // The app deletes itself on the background thread once the loop exits, so take the handle first.
+    pthread_t backgroundThread = m_backgroundThread.value();
+    if (pthread_equal(pthread_self(), backgroundThread))
+    {
+        pthread_detach(backgroundThread);
+        m_taskLoop->Exit(code);
+        return;
+    }
+
     m_taskLoop->Exit(code);
+    pthread_join(backgroundThread, nullptr);
 }
 
 std::shared_ptr<base::SingleThreadTaskRunner> PosixApp::GetTaskRunner(void) const
 {
+    if (!m_engines.empty())
+        return m_engines.front()->GetTaskRunner();
     return m_taskLoop->GetTaskRunner();
 }
 
+bool PosixApp::IsEngineThread(void) const
+{
+    for (const auto &it : m_engines)
+    {
+        if (it->IsCurrent())
+            return true;
+    }
+    return false;
+}
+
+void PosixApp::PrepareForFork(void)
+{
+    // Threads which post into the loop are quiesced first.
+    blink::HTMLParserThread::PrepareForFork();
+    PosixTaskRunner::PrepareForFork();
+    m_taskLoop->PrepareForFork();
+}
+
+void PosixApp::ResumeAfterFork(bool inChild)
+{
+    m_taskLoop->ResumeAfterFork(inChild);
+    PosixTaskRunner::ResumeAfterFork(inChild);
+    blink::HTMLParserThread::ResumeAfterFork(inChild);
+    if (!inChild)
+        return;
+
+    // Thread IDs are different in the child.
+    WTF::ResumeAfterFork();
+    DetachThread(this);
+    m_threadId = CurrentThreadId();
+    AttachThread(this);
+}
+
 int PosixApp::RunAndFinalize(void)
 {
     int exitCode = m_taskLoop->Run();
@@ -39,6 +184,33 @@ int PosixApp::RunAndFinalize(void)
     return exitCode;
 }
 
+void* PosixApp::ShutdownThread(void *arg)
+{
+    delete reinterpret_cast<PosixApp *>(arg);
+    return nullptr;
+}
+
+bool PosixApp::StartEngines(unsigned count)
+{
+    if (0 == count)
+    {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        count = n > 0 ? n : 1;
+    }
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        auto engine = std::make_unique<PosixThread>();
+        if (!engine->Start())
+        {
+            BKLOG("Failed to start engine thread %u.", i);
+            break;
+        }
+        m_engines.emplace_back(std::move(engine));
+    }
+    return !m_engines.empty();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 AppImpl* AppImpl::CreateInstance(int mode, BkAppClient *client)
@@ -48,7 +220,28 @@ AppImpl* AppImpl::CreateInstance(int mode, BkAppClient *client)
 
 void AppImpl::InitializeBackgroundInstance(BkAppClient *client)
 {
-    ASSERT(false); // BKTODO:
+    BackgroundThreadData data;
+    data.client = client;
+
+    pthread_t thread;
+    if (0 != pthread_create(&thread, nullptr, PosixApp::BackgroundThread, &data))
+    {
+        BKLOG("Failed to start the background thread.");
+        return;
+    }
+    data.Wait();
+}
+
+bool AppImpl::InitializePoolInstance(BkAppClient *client)
+{
+    PosixApp *app = new PosixApp(BK_APP_POOL_MODE, client);
+    app->Initialize(nullptr);
+    if (!app->StartEngines(app->Client().PoolSize))
+    {
+        delete app;
+        return false;
+    }
+    return true;
 }
 
 void AppImpl::Log(const char *s)
@@ -57,3 +250,33 @@ void AppImpl::Log(const char *s)
 }
 
 } // namespace BlinKit
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace BlinKit;
+
+extern "C" {
+
+BKEXPORT int BKAPI BkGetTaskFd(void)
+{
+    PosixApp &app = PosixApp::Get();
+    if (BK_APP_MAINTHREAD_MODE != app.Mode())
+    {
+        BKLOG("BkGetTaskFd is for mainthread mode only.");
+        return -1;
+    }
+    return app.GetTaskLoop().FileDescriptor();
+}
+
+BKEXPORT bool_t BKAPI BkPumpTasks(unsigned budgetInUs)
+{
+    PosixApp &app = PosixApp::Get();
+    if (BK_APP_MAINTHREAD_MODE != app.Mode())
+    {
+        BKLOG("BkPumpTasks is for mainthread mode only.");
+        return false;
+    }
+    return app.GetTaskLoop().Pump(budgetInUs);
+}
+
+} // extern "C"
@@ -14,10 +14,14 @@
 
 #pragma once
 
+#include <optional>
+#include <pthread.h>
+#include <vector>
 #include "blinkit/app/app_impl.h"
 
 namespace BlinKit {
 
+class PosixThread;
 class TaskLoop;
 
 class PosixApp final : public AppImpl
@@ -25,14 +29,30 @@ class PosixApp final : public AppImpl
 public:
     PosixApp(int mode, BkAppClient *client);
     ~PosixApp(void) override;
+
+    static PosixApp& Get(void);
+    TaskLoop& GetTaskLoop(void) { return *m_taskLoop; }
+    // Called around fork, see PreforkSupervisor::Spawn.
+    void PrepareForFork(void);
+    void ResumeAfterFork(bool inChild);
 private:
+    friend class AppImpl;
+
+    static void* BackgroundThread(void *arg);
+    static void* ShutdownThread(void *arg);
+    bool IsEngineThread(void) const;
+    bool StartEngines(unsigned count);
+
     // Thread
     std::shared_ptr<base::SingleThreadTaskRunner> GetTaskRunner(void) const override;
     // AppImpl
     int RunAndFinalize(void) override;
     void Exit(int code) override;
+    bool Dispatch(const std::function<void()> &task) override;
 
     std::unique_ptr<TaskLoop> m_taskLoop;
+    std::vector<std::unique_ptr<PosixThread>> m_engines;
+    std::optional<pthread_t> m_backgroundThread;
 };
 
 } // namespace BlinKit
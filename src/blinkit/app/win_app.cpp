@@ -201,6 +201,12 @@ void AppImpl::InitializeBackgroundInstance(BkAppClient *client)
     WaitForSingleObject(data.hEvent, INFINITE);
 }
 
+bool AppImpl::InitializePoolInstance(BkAppClient *client)
+{
+    BKLOG("The pool mode is not supported on this platform yet.");
+    return false;
+}
+
 void AppImpl::Log(const char *s)
 {
     std::wstring ws = base::SysUTF8ToWide(s);
@@ -11,75 +11,263 @@
 
 #include "cookie_jar_impl.h"
 
+#include "base/strings/string_util.h"
+#include "blinkit/blink_impl/cookie_snapshot.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/cookies/canonical_cookie.h"
 #include "url/gurl.h"
 
-#include "public/platform/WebURL.h"
-
-using namespace blink;
 using namespace net;
 
-typedef std::lock_guard<std::recursive_mutex> AutoLock;
-
 namespace BlinKit {
 
+typedef std::unique_lock<std::shared_mutex> AutoLock;
+typedef std::shared_lock<std::shared_mutex> AutoSharedLock;
+
 CookieJarImpl::CookieJarImpl(void)
 {
     m_options.set_include_httponly();
 }
 
-CookieJarImpl::~CookieJarImpl(void)
-{
-    // Nothing
-}
+CookieJarImpl::~CookieJarImpl(void) = default;
 
 void CookieJarImpl::AddCookieEntry(const std::string &URL, const std::string &cookie)
 {
+    const base::Time now = base::Time::Now();
+
+    std::unique_ptr<CanonicalCookie> c(CanonicalCookie::Create(GURL(URL), cookie, now, m_options));
+    if (!c)
+    {
+        BKLOG("Parse cookie failed! Cookie line: %s", cookie.c_str());
+        return;
+    }
+
+    const std::string key = DomainKey(c->Domain());
+    const std::string path = c->Path();
+
+    TakeFromSnapshot(key);
+
     AutoLock lock(m_lock);
 
-    CanonicalCookie *c = CanonicalCookie::Create(GURL(URL), cookie, base::Time::Now(), m_options);
-    if (nullptr != c)
-        m_cookies.push_back(std::unique_ptr<CanonicalCookie>(c));
+    PathMap &paths = m_domains[key];
+    PurgeExpired(paths, now);
+
+    CookieList &cookies = paths[path];
+    auto it = std::find_if(cookies.begin(), cookies.end(), [&c](const std::unique_ptr<CanonicalCookie> &existing) {
+        return existing->IsEquivalent(*c);
+    });
+
+    if (c->IsExpired(now))
+    {
+        // An expiry date in the past is how servers delete cookies.
+        if (cookies.end() != it)
+            cookies.erase(it);
+    }
+    else if (cookies.end() != it)
+    {
+        *it = std::move(c);
+    }
     else
-        BKLOG("Parse cookie failed! Cookie line: %s", cookie.c_str());
-}
+    {
+        cookies.push_back(std::move(c));
+    }
 
-WebString CookieJarImpl::cookieRequestHeaderFieldValue(const WebURL &URL, const WebURL &firstPartyForCookies)
-{
-    assert(false); // BKTODO:
-    return WebString();
+    if (cookies.empty())
+        paths.erase(path);
+    if (paths.empty())
+        m_domains.erase(key);
 }
 
-WebString CookieJarImpl::cookies(const WebURL &URL, const WebURL &firstPartyForCookies)
+std::string CookieJarImpl::DomainKey(const std::string &host)
 {
-    std::string cookies = GetCookies(URL.string().utf8());
-    return WebString::fromUTF8(cookies);
+    std::string h = base::StartsWith(host, ".", base::CompareCase::SENSITIVE) ? host.substr(1) : host;
+    std::string ret = registry_controlled_domains::GetDomainAndRegistry(h,
+        registry_controlled_domains::EXCLUDE_PRIVATE_REGISTRIES);
+    return ret.empty() ? h : ret;
 }
 
-std::string CookieJarImpl::GetCookies(const std::string &URL) const
+std::string CookieJarImpl::GetCookies(const std::string &URL)
 {
-    AutoLock l(m_lock);
+    std::string ret;
 
     GURL u(URL);
-    std::string ret;
-    for (const auto &cookie : m_cookies)
+    if (!u.is_valid() || !u.has_host())
+        return ret;
+
+    const std::string key = DomainKey(u.host());
+    const base::Time now = base::Time::Now();
+    bool hasExpired = false;
+
+    TakeFromSnapshot(key);
+
     {
-        if (!cookie->IncludeForRequestURL(u, m_options))
-            continue;
-
-        if (!ret.empty())
-            ret.append("; ");
-        ret.append(cookie->Name());
-        ret.push_back('=');
-        ret.append(cookie->Value());
+        AutoSharedLock lock(m_lock);
+
+        auto domain = m_domains.find(key);
+        if (m_domains.end() == domain)
+            return ret;
+
+        // Cookies with longer paths are listed first (RFC 6265, 5.4), so probe
+        // the request path, then each of its prefixes which may be a cookie
+        // path: "/a/b" matches cookies on "/a/b", "/a/", "/a" and "/".
+        const std::string &path = u.path();
+        std::vector<std::string> candidates(1, path);
+        for (size_t i = path.length(); i-- > 0;)
+        {
+            if ('/' != path[i])
+                continue;
+            if (i + 1 < path.length())
+                candidates.emplace_back(path, 0, i + 1);
+            if (i > 0 && '/' != path[i - 1])
+                candidates.emplace_back(path, 0, i);
+        }
+
+        const PathMap &paths = domain->second;
+        for (const std::string &candidate : candidates)
+        {
+            auto it = paths.find(candidate);
+            if (paths.end() == it)
+                continue;
+
+            for (const auto &cookie : it->second)
+            {
+                if (cookie->IsExpired(now))
+                {
+                    hasExpired = true;
+                    continue;
+                }
+                if (!cookie->IncludeForRequestURL(u, m_options))
+                    continue;
+
+                if (!ret.empty())
+                    ret.append("; ");
+                ret.append(cookie->Name());
+                ret.push_back('=');
+                ret.append(cookie->Value());
+            }
+        }
+    }
+
+    if (hasExpired)
+    {
+        AutoLock lock(m_lock);
+        auto domain = m_domains.find(key);
+        if (m_domains.end() != domain)
+        {
+            PurgeExpired(domain->second, now);
+            if (domain->second.empty())
+                m_domains.erase(domain);
+        }
     }
 
     return ret;
 }
 
-void CookieJarImpl::setCookie(const WebURL &URL, const WebURL &firstPartyForCookies, const WebString &cookie)
+bool CookieJarImpl::LoadSnapshot(const std::string &fileName)
+{
+    std::unique_ptr<CookieSnapshot> snapshot = CookieSnapshot::Open(fileName);
+    if (!snapshot)
+        return false;
+
+    AutoLock lock(m_lock);
+    m_snapshot = std::move(snapshot);
+    m_hasSnapshot.store(!m_snapshot->IsEmpty(), std::memory_order_release);
+    return true;
+}
+
+void CookieJarImpl::PurgeExpired(PathMap &paths, const base::Time &now)
+{
+    for (auto it = paths.begin(); paths.end() != it;)
+    {
+        CookieList &cookies = it->second;
+        cookies.erase(std::remove_if(cookies.begin(), cookies.end(), [&now](const std::unique_ptr<CanonicalCookie> &c) {
+            return c->IsExpired(now);
+        }), cookies.end());
+
+        if (cookies.empty())
+            it = paths.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool CookieJarImpl::SaveSnapshot(const std::string &fileName)
+{
+    std::unique_lock<std::mutex> saveLock(m_saveLock);
+
+    CookieSnapshotWriter writer;
+    const base::Time now = base::Time::Now();
+
+    {
+        AutoSharedLock lock(m_lock);
+
+        for (const auto &domain : m_domains)
+        {
+            writer.BeginDomain(domain.first);
+            for (const auto &path : domain.second)
+            {
+                for (const auto &cookie : path.second)
+                {
+                    if (!cookie->IsExpired(now))
+                        writer.AddCookie(*cookie);
+                }
+            }
+            writer.EndDomain();
+        }
+
+        // Domains which have not been looked up are copied as they are.
+        if (m_snapshot)
+        {
+            m_snapshot->ForEachRecord([&writer](const std::string &key, const char *data, size_t size) {
+                writer.AddRecord(key, data, size);
+            });
+        }
+    }
+
+    return writer.Save(fileName);
+}
+
+void CookieJarImpl::TakeFromSnapshot(const std::string &key)
 {
-    AddCookieEntry(URL.string().utf8(), cookie.utf8());
+    if (!m_hasSnapshot.load(std::memory_order_acquire))
+        return;
+
+    {
+        AutoSharedLock lock(m_lock);
+        if (!m_snapshot || !m_snapshot->Contains(key))
+            return;
+    }
+
+    AutoLock lock(m_lock);
+    if (!m_snapshot)
+        return;
+
+    CookieSnapshot::CookieList cookies;
+    if (m_snapshot->Take(key, cookies))
+    {
+        const base::Time now = base::Time::Now();
+        PathMap &paths = m_domains[key];
+        for (auto &c : cookies)
+        {
+            if (c->IsExpired(now))
+                continue;
+
+            CookieList &list = paths[c->Path()];
+            bool overridden = std::any_of(list.begin(), list.end(), [&c](const std::unique_ptr<CanonicalCookie> &existing) {
+                return existing->IsEquivalent(*c);
+            });
+            if (!overridden)
+                list.push_back(std::move(c));
+        }
+        if (paths.empty())
+            m_domains.erase(key);
+    }
+
+    if (m_snapshot->IsEmpty())
+    {
+        m_snapshot.reset();
+        m_hasSnapshot.store(false, std::memory_order_release);
+    }
 }
 
 } // namespace BlinKit
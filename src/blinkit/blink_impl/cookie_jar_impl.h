@@ -14,33 +14,61 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
-#include "public/platform/WebCookieJar.h"
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "net/cookies/cookie_options.h"
 
+namespace base {
+class Time;
+}
+
 namespace net {
 class CanonicalCookie;
 }
 
 namespace BlinKit {
 
-class CookieJarImpl final : public blink::WebCookieJar
+class CookieSnapshot;
+
+// Cookies are bucketed by the registrable domain (eTLD+1) of the cookie
+// domain, and then by cookie path, so a lookup only visits the cookies which
+// may apply to the request: the paths are probed from the request path up to
+// "/". Setting a cookie replaces the one with the same name, domain and path.
+// Expired cookies are dropped lazily, when they are met by a lookup or when
+// their bucket is written.
+// A snapshot file can be attached to restore the jar of a previous process,
+// its domains are decoded on their first lookup; cookies set in the meantime
+// take precedence over the ones in the snapshot.
+class CookieJarImpl
 {
 public:
     CookieJarImpl(void);
     ~CookieJarImpl(void);
 
     void AddCookieEntry(const std::string &URL, const std::string &cookie);
-    std::string GetCookies(const std::string &URL) const;
+    std::string GetCookies(const std::string &URL);
+
+    bool LoadSnapshot(const std::string &fileName);
+    bool SaveSnapshot(const std::string &fileName);
 private:
-    // blink::WebCookieJar
-    void setCookie(const blink::WebURL&, const blink::WebURL& firstPartyForCookies, const blink::WebString& cookie) override;
-    blink::WebString cookies(const blink::WebURL&, const blink::WebURL& firstPartyForCookies) override;
-    blink::WebString cookieRequestHeaderFieldValue(const blink::WebURL&, const blink::WebURL& firstPartyForCookies) override;
+    using CookieList = std::vector<std::unique_ptr<net::CanonicalCookie>>;
+    using PathMap = std::unordered_map<std::string, CookieList>;
+
+    static std::string DomainKey(const std::string &host);
+    static void PurgeExpired(PathMap &paths, const base::Time &now);
+    void TakeFromSnapshot(const std::string &key);
 
-    mutable std::recursive_mutex m_lock;
+    std::shared_mutex m_lock;
+    std::mutex m_saveLock; // Snapshots are saved one by one, so a later one is never replaced by an earlier one.
     net::CookieOptions m_options;
-    std::vector<std::unique_ptr<net::CanonicalCookie>> m_cookies;
+    std::unordered_map<std::string, PathMap> m_domains;
+    std::unique_ptr<CookieSnapshot> m_snapshot;
+    std::atomic<bool> m_hasSnapshot{ false };
 };
 
 } // namespace BlinKit
@@ -0,0 +1,371 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: cookie_snapshot.cpp
+// Description: Cookie Snapshot Classes
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "cookie_snapshot.h"
+
+#include <atomic>
+#include "net/cookies/canonical_cookie.h"
+#include "url/gurl.h"
+#if !OS_WIN
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace net;
+
+namespace BlinKit {
+
+static const char Magic[4] = { 'B', 'K', 'C', 'J' };
+static const uint32_t Version = 1;
+
+enum CookieFlags {
+    CookieSecure         = 0x01,
+    CookieHttpOnly       = 0x02,
+    CookieFirstPartyOnly = 0x04
+};
+
+namespace {
+
+class Reader
+{
+public:
+    Reader(const char *data, size_t size) : m_p(data), m_end(data + size) {}
+
+    bool ReadU8(uint8_t &ret)
+    {
+        if (m_p >= m_end)
+            return false;
+        ret = static_cast<uint8_t>(*m_p++);
+        return true;
+    }
+
+    bool ReadU32(uint32_t &ret)
+    {
+        if (m_end - m_p < 4)
+            return false;
+        const uint8_t *b = reinterpret_cast<const uint8_t *>(m_p);
+        ret = b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<uint32_t>(b[3]) << 24);
+        m_p += 4;
+        return true;
+    }
+
+    bool ReadVarint(uint64_t &ret)
+    {
+        ret = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t b;
+            if (!ReadU8(b))
+                return false;
+            ret |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (0 == (b & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool ReadString(std::string &ret)
+    {
+        uint64_t length;
+        if (!ReadVarint(length) || static_cast<uint64_t>(m_end - m_p) < length)
+            return false;
+        ret.assign(m_p, length);
+        m_p += length;
+        return true;
+    }
+
+    bool ReadTime(base::Time &ret)
+    {
+        uint64_t us;
+        if (!ReadVarint(us))
+            return false;
+        ret = base::Time() + base::TimeDelta::FromMicroseconds(static_cast<int64_t>(us));
+        return true;
+    }
+
+    size_t Offset(const char *base) const { return m_p - base; }
+private:
+    const char *m_p;
+    const char *m_end;
+};
+
+void WriteU32(std::string &dst, uint32_t n)
+{
+    for (int i = 0; i < 4; ++i)
+        dst.push_back(static_cast<char>((n >> (i * 8)) & 0xff));
+}
+
+void PatchU32(std::string &dst, size_t offset, uint32_t n)
+{
+    for (int i = 0; i < 4; ++i)
+        dst[offset + i] = static_cast<char>((n >> (i * 8)) & 0xff);
+}
+
+void WriteVarint(std::string &dst, uint64_t n)
+{
+    while (n >= 0x80)
+    {
+        dst.push_back(static_cast<char>((n & 0x7f) | 0x80));
+        n >>= 7;
+    }
+    dst.push_back(static_cast<char>(n));
+}
+
+void WriteString(std::string &dst, const std::string &s)
+{
+    WriteVarint(dst, s.length());
+    dst.append(s);
+}
+
+void WriteTime(std::string &dst, const base::Time &t)
+{
+    WriteVarint(dst, static_cast<uint64_t>(t.since_origin().InMicroseconds()));
+}
+
+} // namespace
+
+CookieSnapshot::~CookieSnapshot(void)
+{
+#if !OS_WIN
+    if (nullptr != m_mapped)
+        munmap(m_mapped, m_size);
+#endif
+}
+
+void CookieSnapshot::ForEachRecord(const RecordCallback &callback) const
+{
+    for (const auto &it : m_index)
+        callback(it.first, m_data + it.second.offset, it.second.size);
+}
+
+bool CookieSnapshot::Map(const std::string &fileName)
+{
+#if OS_WIN
+    // A mapped file cannot be replaced on Windows, which saving the snapshot does, so read it instead.
+    FILE *fp = fopen(fileName.c_str(), "rb");
+    if (nullptr == fp)
+        return false;
+
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+        m_buffer.append(buf, n);
+    fclose(fp);
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.length();
+    return true;
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (0 != fstat(fd, &st) || 0 == st.st_size)
+    {
+        close(fd);
+        return false;
+    }
+
+    void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == p)
+        return false;
+
+    m_mapped = p;
+    m_data = static_cast<const char *>(p);
+    m_size = st.st_size;
+    return true;
+#endif
+}
+
+std::unique_ptr<CookieSnapshot> CookieSnapshot::Open(const std::string &fileName)
+{
+    std::unique_ptr<CookieSnapshot> ret(new CookieSnapshot);
+    if (!ret->Map(fileName))
+        return nullptr;
+    if (!ret->ParseIndex())
+    {
+        BKLOG("Invalid cookie snapshot: %s", fileName.c_str());
+        return nullptr;
+    }
+    return ret;
+}
+
+bool CookieSnapshot::ParseIndex(void)
+{
+    if (m_size < sizeof(Magic) || 0 != memcmp(m_data, Magic, sizeof(Magic)))
+        return false;
+
+    Reader reader(m_data + sizeof(Magic), m_size - sizeof(Magic));
+
+    uint32_t version, count;
+    if (!reader.ReadU32(version) || Version != version)
+        return false;
+    if (!reader.ReadU32(count))
+        return false;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        std::string key;
+        uint32_t offset, size;
+        if (!reader.ReadString(key) || !reader.ReadU32(offset) || !reader.ReadU32(size))
+            return false;
+        if (offset > m_size || size > m_size - offset)
+            return false;
+        m_index[key] = { offset, size };
+    }
+    return true;
+}
+
+bool CookieSnapshot::Take(const std::string &key, CookieList &cookies)
+{
+    auto it = m_index.find(key);
+    if (std::end(m_index) == it)
+        return false;
+
+    Reader reader(m_data + it->second.offset, it->second.size);
+    m_index.erase(it);
+
+    uint32_t count;
+    if (!reader.ReadU32(count))
+        return false;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        std::string name, value, domain, path;
+        base::Time creation, expiry, lastAccess;
+        uint8_t flags, priority;
+        if (!reader.ReadString(name) || !reader.ReadString(value) || !reader.ReadString(domain)
+            || !reader.ReadString(path) || !reader.ReadTime(creation) || !reader.ReadTime(expiry)
+            || !reader.ReadTime(lastAccess) || !reader.ReadU8(flags) || !reader.ReadU8(priority))
+        {
+            BKLOG("Broken cookie record for %s.", key.c_str());
+            return false;
+        }
+
+        if (priority > COOKIE_PRIORITY_HIGH)
+            priority = COOKIE_PRIORITY_DEFAULT;
+        cookies.emplace_back(std::make_unique<CanonicalCookie>(GURL(), name, value, domain, path,
+            creation, expiry, lastAccess,
+            0 != (flags & CookieSecure), 0 != (flags & CookieHttpOnly), 0 != (flags & CookieFirstPartyOnly),
+            static_cast<CookiePriority>(priority)));
+    }
+    return true;
+}
+
+void CookieSnapshotWriter::AddCookie(const CanonicalCookie &cookie)
+{
+    WriteString(m_records, cookie.Name());
+    WriteString(m_records, cookie.Value());
+    WriteString(m_records, cookie.Domain());
+    WriteString(m_records, cookie.Path());
+    WriteTime(m_records, cookie.CreationDate());
+    WriteTime(m_records, cookie.ExpiryDate());
+    WriteTime(m_records, cookie.LastAccessDate());
+
+    uint8_t flags = 0;
+    if (cookie.IsSecure())
+        flags |= CookieSecure;
+    if (cookie.IsHttpOnly())
+        flags |= CookieHttpOnly;
+    if (cookie.IsFirstPartyOnly())
+        flags |= CookieFirstPartyOnly;
+    m_records.push_back(static_cast<char>(flags));
+    m_records.push_back(static_cast<char>(cookie.Priority()));
+
+    ++m_count;
+}
+
+void CookieSnapshotWriter::AddRecord(const std::string &key, const char *data, size_t size)
+{
+    m_entries.push_back({ key, m_records.length(), size });
+    m_records.append(data, size);
+}
+
+void CookieSnapshotWriter::BeginDomain(const std::string &key)
+{
+    m_countOffset = m_records.length();
+    m_count = 0;
+    m_entries.push_back({ key, m_countOffset, 0 });
+    WriteU32(m_records, 0);
+}
+
+void CookieSnapshotWriter::EndDomain(void)
+{
+    if (0 == m_count)
+    {
+        m_records.resize(m_countOffset);
+        m_entries.pop_back();
+        return;
+    }
+
+    PatchU32(m_records, m_countOffset, m_count);
+    m_entries.back().size = m_records.length() - m_countOffset;
+}
+
+bool CookieSnapshotWriter::Save(const std::string &fileName) const
+{
+    std::string header(Magic, sizeof(Magic));
+    WriteU32(header, Version);
+    WriteU32(header, static_cast<uint32_t>(m_entries.size()));
+
+    size_t indexSize = 0;
+    for (const Entry &e : m_entries)
+    {
+        std::string length;
+        WriteVarint(length, e.key.length());
+        indexSize += length.length() + e.key.length() + 8;
+    }
+
+    const size_t recordsOffset = header.length() + indexSize;
+    for (const Entry &e : m_entries)
+    {
+        WriteString(header, e.key);
+        WriteU32(header, static_cast<uint32_t>(recordsOffset + e.offset));
+        WriteU32(header, static_cast<uint32_t>(e.size));
+    }
+    ASSERT(header.length() == recordsOffset);
+
+    static std::atomic<unsigned> s_sequence{ 0 };
+
+    // Unique among processes sharing the snapshot, which rename their own files into place.
+    char suffix[64];
+#if OS_WIN
+    const unsigned long pid = GetCurrentProcessId();
+#else
+    const unsigned long pid = getpid();
+#endif
+    snprintf(suffix, sizeof(suffix), ".%lu.%u.tmp", pid, s_sequence.fetch_add(1));
+    const std::string tempFileName = fileName + suffix;
+    FILE *fp = fopen(tempFileName.c_str(), "wb");
+    if (nullptr == fp)
+        return false;
+
+    bool ok = header.length() == fwrite(header.data(), 1, header.length(), fp)
+        && m_records.length() == fwrite(m_records.data(), 1, m_records.length(), fp);
+    ok = 0 == fclose(fp) && ok;
+    if (!ok)
+    {
+        remove(tempFileName.c_str());
+        return false;
+    }
+
+#if OS_WIN
+    return MoveFileExA(tempFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+    return 0 == rename(tempFileName.c_str(), fileName.c_str());
+#endif
+}
+
+} // namespace BlinKit
@@ -0,0 +1,98 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: cookie_snapshot.h
+// Description: Cookie Snapshot Classes
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINKIT_COOKIE_SNAPSHOT_H
+#define BLINKIT_BLINKIT_COOKIE_SNAPSHOT_H
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace net {
+class CanonicalCookie;
+}
+
+namespace BlinKit {
+
+// Snapshot file layout, all integers are little endian:
+//   Header: "BKCJ", u32 version, u32 domain count.
+//   Index:  for each domain, varint key length, key, u32 record offset, u32 record size.
+//   Record: u32 cookie count, then for each cookie:
+//           name, value, domain and path, each one as varint length + bytes,
+//           creation, expiry and last access time as varint microseconds,
+//           u8 flags, u8 priority.
+// Records are addressed by the index, so a domain is only decoded when it is looked up.
+
+class CookieSnapshot
+{
+public:
+    using CookieList = std::vector<std::unique_ptr<net::CanonicalCookie>>;
+
+    static std::unique_ptr<CookieSnapshot> Open(const std::string &fileName);
+    ~CookieSnapshot(void);
+
+    bool IsEmpty(void) const { return m_index.empty(); }
+    bool Contains(const std::string &key) const { return std::end(m_index) != m_index.find(key); }
+    // Decodes the cookies of the domain, which is removed from the snapshot then.
+    bool Take(const std::string &key, CookieList &cookies);
+
+    // Enumerates the records not taken yet, so that they can be written back without being decoded.
+    using RecordCallback = std::function<void(const std::string &key, const char *data, size_t size)>;
+    void ForEachRecord(const RecordCallback &callback) const;
+private:
+    CookieSnapshot(void) = default;
+
+    bool Map(const std::string &fileName);
+    bool ParseIndex(void);
+
+    struct Record {
+        size_t offset, size;
+    };
+    std::unordered_map<std::string, Record> m_index;
+
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+#if OS_WIN
+    std::string m_buffer;
+#else
+    void *m_mapped = nullptr;
+#endif
+};
+
+class CookieSnapshotWriter
+{
+public:
+    void BeginDomain(const std::string &key);
+    void AddCookie(const net::CanonicalCookie &cookie);
+    void EndDomain(void);
+
+    void AddRecord(const std::string &key, const char *data, size_t size);
+
+    // Writes to a temporary file first, which replaces |fileName| when done.
+    bool Save(const std::string &fileName) const;
+private:
+    struct Entry {
+        std::string key;
+        size_t offset, size;
+    };
+    std::vector<Entry> m_entries;
+    std::string m_records;
+    size_t m_countOffset = 0;
+    uint32_t m_count = 0;
+};
+
+} // namespace BlinKit
+
+#endif // BLINKIT_BLINKIT_COOKIE_SNAPSHOT_H
@@ -12,6 +12,8 @@
 #include "posix_task_runner.h"
 
 #include <pthread.h>
+#include <time.h>
+#include <unordered_set>
 
 namespace BlinKit {
 
@@ -22,55 +24,122 @@ public:
         : m_taskPoster(taskPoster)
         , m_location(location)
         , m_task(task)
-        , m_delayInMs(delay.InMilliseconds())
     {
+        // Timed by a deadline, so that the wait can be picked up again by a new thread after fork.
+        const int64_t delayInMs = delay.InMilliseconds();
+        clock_gettime(CLOCK_MONOTONIC, &m_deadline);
+        m_deadline.tv_sec += delayInMs / 1000;
+        m_deadline.tv_nsec += (delayInMs % 1000) * 1000000;
+        if (m_deadline.tv_nsec >= 1000000000)
+        {
+            ++m_deadline.tv_sec;
+            m_deadline.tv_nsec -= 1000000000;
+        }
     }
-    ~DelayData(void)
+
+    void Wait(void) const
     {
-        timespec t;
-        t.tv_sec = m_delayInMs / 1000;
-        t.tv_nsec = (m_delayInMs % 1000) * 1000000;
-        nanosleep(&t, nullptr);
-        m_taskPoster(m_location, m_task);
+        while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &m_deadline, nullptr));
     }
+    void Post(void) const { m_taskPoster(m_location, m_task); }
 private:
     const PosixTaskRunner::TaskPoster m_taskPoster;
     const base::Location m_location;
     const std::function<void()> m_task;
-    int64_t m_delayInMs;
+    timespec m_deadline;
 };
 
+// The delays waited for by the delay threads, which are started again in a forked child.
+static pthread_mutex_t g_delayLock = PTHREAD_MUTEX_INITIALIZER;
+
+static std::unordered_set<DelayData *>& PendingDelays(void)
+{
+    static std::unordered_set<DelayData *> s_delays;
+    return s_delays;
+}
+
 PosixTaskRunner::PosixTaskRunner(const TaskPoster &taskPoster) : m_taskPoster(taskPoster)
 {
 }
 
 static void* DelayThread(void *arg)
 {
-    delete reinterpret_cast<DelayData *>(arg);
+    DelayData *delayData = reinterpret_cast<DelayData *>(arg);
+    delayData->Wait();
+
+    // Posted under the lock, so a fork never sees the task both pending & posted.
+    pthread_mutex_lock(&g_delayLock);
+    PendingDelays().erase(delayData);
+    delayData->Post();
+    pthread_mutex_unlock(&g_delayLock);
+
+    delete delayData;
     return nullptr;
 }
 
+static bool StartDelayThread(DelayData *delayData)
+{
+    pthread_t t;
+    if (0 != pthread_create(&t, nullptr, DelayThread, delayData))
+        return false;
+    pthread_detach(t);
+    return true;
+}
+
 bool PosixTaskRunner::PostDelayedTask(const base::Location &fromHere, const std::function<void()> &task, base::TimeDelta delay)
 {
     if (delay.is_zero())
     {
         m_taskPoster(fromHere, task);
+        return true;
     }
-    else
+
+    DelayData *delayData = new DelayData(m_taskPoster, fromHere, task, delay);
+
+    pthread_mutex_lock(&g_delayLock);
+    PendingDelays().insert(delayData);
+    pthread_mutex_unlock(&g_delayLock);
+
+    if (StartDelayThread(delayData))
+        return true;
+
+    ASSERT(false); // Error: Cannot create the delay thread!
+    pthread_mutex_lock(&g_delayLock);
+    PendingDelays().erase(delayData);
+    pthread_mutex_unlock(&g_delayLock);
+    delete delayData;
+    return false;
+}
+
+void PosixTaskRunner::PrepareForFork(void)
+{
+    pthread_mutex_lock(&g_delayLock);
+}
+
+void PosixTaskRunner::ResumeAfterFork(bool inChild)
+{
+    if (!inChild)
     {
-        DelayData *delayData = new DelayData(m_taskPoster, fromHere, task, delay);
+        pthread_mutex_unlock(&g_delayLock);
+        return;
+    }
 
-        pthread_t t;
-        if (0 != pthread_create(&t, nullptr, DelayThread, delayData))
+    pthread_mutex_init(&g_delayLock, nullptr);
+
+    std::unordered_set<DelayData *> &delays = PendingDelays();
+    for (auto it = delays.begin(); it != delays.end();)
+    {
+        DelayData *delayData = *it;
+        if (StartDelayThread(delayData))
         {
-            ASSERT(false); // Error: Cannot create the delay thread!
-            delete delayData;
-            return false;
+            ++it;
+            continue;
         }
 
-        pthread_detach(t);
+        BKLOG("Failed to restart a delay thread after fork.");
+        it = delays.erase(it);
+        delete delayData;
     }
-    return true;
 }
 
 } // namespace BlinKit
@@ -24,6 +24,11 @@ public:
     typedef std::function<void(const base::Location &, const std::function<void()> &)> TaskPoster;
 
     PosixTaskRunner(const TaskPoster &taskPoster);
+
+    // Delay threads do not survive fork. PrepareForFork holds the pending delays until ResumeAfterFork, which starts
+    // the threads again in the child.
+    static void PrepareForFork(void);
+    static void ResumeAfterFork(bool inChild);
 private:
     // TaskRunner overrides
     bool PostDelayedTask(const base::Location &fromHere, const std::function<void()> &task, base::TimeDelta delay) override;
@@ -14,13 +14,51 @@
 #   include <sys/syscall.h>
 #endif
 
+#include "blinkit/posix/task_loop.h"
+#include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
+
 using namespace blink;
 
 namespace BlinKit {
 
+PosixThread::PosixThread(void) : m_taskLoop(std::make_unique<TaskLoop>())
+{
+    m_taskRunner = m_taskLoop->GetTaskRunner();
+}
+
+PosixThread::~PosixThread(void)
+{
+    if (m_started)
+    {
+        m_taskLoop->Exit(EXIT_SUCCESS);
+        pthread_join(m_thread, nullptr);
+    }
+}
+
 std::shared_ptr<base::SingleThreadTaskRunner> PosixThread::GetTaskRunner(void) const
 {
-    ASSERT(false); // BKTODO:
+    return m_taskRunner;
+}
+
+bool PosixThread::Start(void)
+{
+    ASSERT(!m_started);
+    m_started = 0 == pthread_create(&m_thread, nullptr, ThreadProc, this);
+    return m_started;
+}
+
+void* PosixThread::ThreadProc(void *arg)
+{
+    PosixThread *thread = reinterpret_cast<PosixThread *>(arg);
+
+    thread->m_threadId = CurrentThreadId();
+    WTF::InitializeEngineThread();
+    Platform::Current()->AttachThread(thread);
+
+    thread->m_taskLoop->Run();
+
+    Platform::Current()->DetachThread(thread);
     return nullptr;
 }
 
@@ -14,15 +14,32 @@
 
 #pragma once
 
+#include <pthread.h>
 #include "blinkit/blink_impl/thread_impl.h"
 
 namespace BlinKit {
-    
+
+class TaskLoop;
+
+// A thread running its own task loop, used as an engine of the pool mode.
 class PosixThread final : public ThreadImpl
 {
-private:
+public:
+    PosixThread(void);
+    ~PosixThread(void) override;
+
+    bool Start(void);
+    bool IsCurrent(void) const { return m_started && pthread_equal(pthread_self(), m_thread); }
+
     // Thread overrides
     std::shared_ptr<base::SingleThreadTaskRunner> GetTaskRunner(void) const override;
+private:
+    static void* ThreadProc(void *arg);
+
+    std::unique_ptr<TaskLoop> m_taskLoop;
+    std::shared_ptr<base::SingleThreadTaskRunner> m_taskRunner;
+    pthread_t m_thread;
+    bool m_started = false;
 };
 
 } // namespace BlinKit
@@ -11,12 +11,19 @@
 
 #include "thread_impl.h"
 
+#include "third_party/blink/public/platform/platform.h"
+
 using namespace blink;
 
 namespace BlinKit {
 
 ThreadImpl::~ThreadImpl(void) = default;
 
+ThreadImpl* ThreadImpl::Current(void)
+{
+    return static_cast<ThreadImpl *>(Platform::Current()->CurrentThread());
+}
+
 bool ThreadImpl::IsCurrentThread(void) const
 {
     return CurrentThreadId() == ThreadId();
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
 
 namespace BlinKit {
@@ -24,12 +25,19 @@ class ThreadImpl : public blink::Thread
 {
 public:
     static blink::PlatformThreadId CurrentThreadId(void);
+    static ThreadImpl* Current(void);
 
     blink::PlatformThreadId ThreadId(void) const final
     {
         ASSERT(0 != m_threadId); // BKTODO: Initialize id in other threads.
         return m_threadId;
     }
+
+    // Crawlers living on this thread, plus tasks queued for it, used by the
+    // pool mode to pick the least loaded engine.
+    unsigned Load(void) const { return m_load; }
+    void IncreaseLoad(void) { ++m_load; }
+    void DecreaseLoad(void) { --m_load; }
 protected:
     ThreadImpl(void) = default;
     ~ThreadImpl(void) override;
@@ -37,6 +45,8 @@ protected:
     bool IsCurrentThread(void) const final;
 
     blink::PlatformThreadId m_threadId = 0;
+private:
+    std::atomic<unsigned> m_load{ 0 };
 };
 
 } // namespace BlinKit
@@ -24,18 +24,25 @@ URLLoaderImpl::URLLoaderImpl(const std::shared_ptr<base::SingleThreadTaskRunner>
     // Nothing
 }
 
-URLLoaderImpl::~URLLoaderImpl(void) = default;
+URLLoaderImpl::~URLLoaderImpl(void)
+{
+    // The task may go on without a loader, but must not call the client any more.
+    if (m_client)
+        *m_client = nullptr;
+}
 
 void URLLoaderImpl::LoadAsynchronously(const ResourceRequest &request, WebURLLoaderClient *client)
 {
     const BkURL &url = request.Url();
+    ASSERT(!m_client);
+    m_client = std::make_shared<WebURLLoaderClient *>(client);
 
     LoaderTask *task = nullptr;
     do {
         if (url.SchemeIsHTTPOrHTTPS())
         {
             ASSERT(nullptr != request.Crawler());
-            task = new HTTPLoaderTask(request.Crawler(), m_taskRunner, client);
+            task = new HTTPLoaderTask(request.Crawler(), m_taskRunner, m_client);
         }
 
     } while (false);
@@ -44,7 +51,7 @@ void URLLoaderImpl::LoadAsynchronously(const ResourceRequest &request, WebURLLoa
     if (nullptr != task)
         error = task->Run(request);
     if (BK_ERR_SUCCESS != error)
-        LoaderTask::ReportError(client, m_taskRunner.get(), error, url);
+        LoaderTask::ReportError(m_client, m_taskRunner.get(), error, url);
 }
 
 } // namespace BlinKit
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "blinkit/loader_tasks/loader_task.h"
 #include "third_party/blink/public/platform/web_url_loader.h"
 
 namespace base {
@@ -32,6 +33,7 @@ private:
     void LoadAsynchronously(const blink::ResourceRequest &request, blink::WebURLLoaderClient *client) override;
 
     std::shared_ptr<base::SingleThreadTaskRunner> m_taskRunner;
+    LoaderTask::ClientRef m_client;
 };
 
 } // namespace BlinKit
@@ -46,13 +46,19 @@ std::string BkHTTPHeaderMap::CanonizeHeaderName(const std::string &header)
     return ret;
 }
 
-std::string BkHTTPHeaderMap::Get(const std::string &name) const
+const std::string* BkHTTPHeaderMap::Find(const std::string &name) const
 {
     std::string canonizedName = CanonizeHeaderName(name);
     auto it = m_headers.find(canonizedName);
     if (std::end(m_headers) == it)
-        return std::string();
-    return it->second;
+        return nullptr;
+    return &(it->second);
+}
+
+std::string BkHTTPHeaderMap::Get(const std::string &name) const
+{
+    const std::string *ret = Find(name);
+    return nullptr != ret ? *ret : std::string();
 }
 
 std::string BkHTTPHeaderMap::GetAllForRequest(void) const
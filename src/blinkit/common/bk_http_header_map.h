@@ -25,6 +25,8 @@ public:
     void Clear(void) { m_headers.clear(); }
 
     std::string Get(const std::string &name) const;
+    // Same as Get, but without copying the value, nullptr if not found.
+    const std::string* Find(const std::string &name) const;
     void Set(const std::string &name, const std::string &val);
 
     void Remove(const std::string &name);
@@ -11,14 +11,26 @@
 
 #include "crawler_impl.h"
 
+#include "base/single_thread_task_runner.h"
+#include "blinkit/blink_impl/thread_impl.h"
 #include "blinkit/common/bk_url.h"
 #include "blinkit/http/response_impl.h"
 #include "blinkit/js/context_impl.h"
+#include "blinkit/loader_tasks/http_loader_task.h"
 #include "blinkit/misc/controller_impl.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/renderer/bindings/core/duk/script_controller.h"
+#include "third_party/blink/renderer/core/css/selector_query.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/editing/serializers/serialization.h"
+#include "third_party/blink/renderer/core/editing/serializers/utf8_markup_writer.h"
+#include "third_party/blink/renderer/core/editing/serializers/visible_text.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/loader/frame_load_request.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
 #include "third_party/blink/renderer/platform/bindings/gc_pool.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_error.h"
 #if 0 // BKTODO:
 #include "app/app_impl.h"
@@ -28,14 +40,76 @@
 using namespace blink;
 using namespace BlinKit;
 
-CrawlerImpl::CrawlerImpl(const BkCrawlerClient &client) : m_client(client), m_frame(LocalFrame::Create(this))
+CrawlerImpl::CrawlerImpl(const BkCrawlerClient &client)
+    : m_frame(LocalFrame::Create(this)), m_transfers(std::make_shared<TransferSet>())
 {
+    memset(&m_client, 0, sizeof(BkCrawlerClient));
+    size_t size = sizeof(BkCrawlerClient);
+    if (client.SizeOfStruct < size)
+        size = client.SizeOfStruct;
+    memcpy(&m_client, &client, size);
+
+    memset(&m_timing, 0, sizeof(BkCrawlTiming));
+    m_timing.SizeOfStruct = sizeof(BkCrawlTiming);
+
+    ThreadImpl::Current()->IncreaseLoad();
     m_frame->Init();
 }
 
 CrawlerImpl::~CrawlerImpl(void)
 {
     m_frame->Detach(FrameDetachType::kRemove);
+
+    // The transfers left, e.g. the ones other crawlers are waiting for, come back later, and must not reach this
+    // crawler then.
+    AbortTransfers();
+    {
+        std::unique_lock<std::mutex> lock(m_transfers->lock);
+        for (HTTPLoaderTask *task : m_transfers->tasks)
+            task->DetachCrawler();
+        m_transfers->tasks.clear();
+    }
+
+    ThreadImpl::Current()->DecreaseLoad();
+}
+
+void CrawlerImpl::AbortTransfers(void)
+{
+    // Transfers on the wire fail with BK_ERR_CANCELLED by themselves, queued ones are failed here.
+    std::vector<HTTPLoaderTask *> queued;
+    {
+        std::unique_lock<std::mutex> lock(m_transfers->lock);
+        for (HTTPLoaderTask *task : m_transfers->tasks)
+        {
+            if (task->Abort())
+                queued.push_back(task);
+        }
+        for (HTTPLoaderTask *task : queued)
+            m_transfers->tasks.erase(task);
+    }
+    for (HTTPLoaderTask *task : queued)
+        task->FailAborted();
+}
+
+bool CrawlerImpl::AllowsLoad(ResourceType type, const BkURL &url)
+{
+    if (m_stopped || m_truncated)
+    {
+        BKLOG("Load denied for the crawl is %s: %s", m_stopped ? "stopped" : "truncated", url.AsString().c_str());
+        return false;
+    }
+    if (m_loadPolicy && !m_loadPolicy->Allows(type, url))
+    {
+        BKLOG("Load denied by policy: %s", url.AsString().c_str());
+        return false;
+    }
+
+    if (ResourceType::kMainResource == type || 0 == m_limits.subresources)
+        return true;
+    if (++m_subresources <= m_limits.subresources)
+        return true;
+    Truncate("subresource limit reached");
+    return false;
 }
 
 bool CrawlerImpl::ApplyConsoleMessager(std::function<void(int, const char *)> &dst) const
@@ -46,16 +120,159 @@ bool CrawlerImpl::ApplyConsoleMessager(std::function<void(int, const char *)> &d
     return true;
 }
 
+void CrawlerImpl::ArmDeadline(void)
+{
+    m_deadlineTask = std::make_shared<CrawlerImpl *>(this);
+
+    std::weak_ptr<CrawlerImpl *> task = m_deadlineTask;
+    std::function<void()> callback = [task] {
+        if (std::shared_ptr<CrawlerImpl *> crawler = task.lock())
+            (*crawler)->Truncate("time limit reached");
+    };
+    m_frame->GetTaskRunner(TaskType::kNetworking)->PostDelayedTask(FROM_HERE, callback,
+        base::TimeDelta::FromMilliseconds(m_limits.timeInMs));
+}
+
+const std::shared_ptr<TransferSet>& CrawlerImpl::AttachTransfer(HTTPLoaderTask *task)
+{
+    std::unique_lock<std::mutex> lock(m_transfers->lock);
+    m_transfers->tasks.insert(task);
+    return m_transfers;
+}
+
+static void AppendField(const Element &element, const BkExtractField &field, std::string &dst)
+{
+    switch (field.Type)
+    {
+        case BK_EXTRACT_OUTER_HTML:
+            AppendMarkupUTF8(dst, element);
+            break;
+        case BK_EXTRACT_INNER_HTML:
+            AppendMarkupUTF8(dst, element, kChildrenOnly);
+            break;
+        case BK_EXTRACT_TEXT:
+            dst.append(element.textContent().StdUtf8());
+            break;
+        case BK_EXTRACT_ATTRIBUTE:
+        {
+            AtomicString name = AtomicString::FromUTF8(field.AttributeName);
+            if (element.IsHTMLElement())
+                name = name.LowerASCII();
+            dst.append(element.getAttribute(QualifiedName(g_null_atom, name, g_null_atom)).StdUtf8());
+            break;
+        }
+        case BK_EXTRACT_VISIBLE_TEXT:
+            AppendVisibleTextUTF8(dst, element);
+            break;
+        default:
+            NOTREACHED();
+    }
+    dst.push_back('\0');
+}
+
+void CrawlerImpl::CountReceivedBytes(size_t bytes)
+{
+    m_receivedBytes += bytes;
+    if (0 != m_limits.bytes && m_receivedBytes > m_limits.bytes)
+        Truncate("byte limit reached");
+}
+
+std::optional<uint64_t> CrawlerImpl::RemainingBytes(void) const
+{
+    if (0 == m_limits.bytes)
+        return std::nullopt;
+    return m_receivedBytes < m_limits.bytes ? m_limits.bytes - m_receivedBytes : 0;
+}
+
+void CrawlerImpl::CountTransfer(const BkResponseTiming &timing)
+{
+    ++m_timing.Transfers;
+    if (timing.ConnectionReused)
+        ++m_timing.ReusedConnections;
+    m_timing.NameLookup += timing.NameLookup;
+    m_timing.Connect += timing.Connect;
+    m_timing.TLSHandshake += timing.TLSHandshake;
+    m_timing.FirstByte += timing.FirstByte;
+    m_timing.Total += timing.Total;
+    m_timing.RequestBytes += timing.RequestBytes;
+    m_timing.HeaderBytes += timing.HeaderBytes;
+    m_timing.BodyBytes += timing.BodyBytes;
+}
+
 void CrawlerImpl::DispatchDidFailProvisionalLoad(const ResourceError &error)
 {
+    m_deadlineTask.reset();
+    if (m_stopped)
+        return;
+
     const std::string URL = error.FailingURL();
     m_client.Error(error.ErrorCode(), URL.c_str(), m_client.UserData);
 }
 
+void CrawlerImpl::DispatchDidFailLoad(const ResourceError &error)
+{
+    // Committed loads fail only by being stopped, see DocumentLoader::StopLoading.
+    m_deadlineTask.reset();
+}
+
+void CrawlerImpl::DispatchDidFinishDocumentLoad(void)
+{
+    if (m_stopped || nullptr == m_client.DOMContentLoaded)
+        return;
+    if (m_client.DOMContentLoaded(m_client.UserData))
+        StopLoadingLater();
+}
+
 void CrawlerImpl::DispatchDidFinishLoad(void)
 {
+    m_deadlineTask.reset();
     m_frame->GetGCPool().CollectGarbage();
-    m_client.DocumentReady(m_client.UserData);
+    if (!m_stopped)
+        m_client.DocumentReady(m_client.UserData);
+}
+
+void CrawlerImpl::DispatchDidParseDocument(void)
+{
+    if (m_stopped || nullptr == m_client.DocumentParsed)
+        return;
+    if (m_client.DocumentParsed(m_client.UserData))
+        StopLoadingLater();
+}
+
+int CrawlerImpl::ExtractElements(const char *selector, const BkExtractField *fields, unsigned fieldCount, BkBuffer *dst)
+{
+    if (nullptr == selector || nullptr == dst || (0 != fieldCount && nullptr == fields))
+        return BK_ERR_RANGE;
+    for (unsigned i = 0; i < fieldCount; ++i)
+    {
+        const BkExtractField &field = fields[i];
+        if (field.Type < BK_EXTRACT_OUTER_HTML || field.Type > BK_EXTRACT_VISIBLE_TEXT)
+            return BK_ERR_RANGE;
+        if (BK_EXTRACT_ATTRIBUTE == field.Type && (nullptr == field.AttributeName || '\0' == *field.AttributeName))
+            return BK_ERR_RANGE;
+    }
+
+    Document *document = m_frame->GetDocument();
+    if (nullptr == document)
+        return BK_ERR_NOT_FOUND;
+
+    TrackExceptionState exceptionState;
+    SelectorQuery *query = document->GetSelectorQueryCache().Add(AtomicString::FromUTF8(selector), *document,
+        exceptionState);
+    if (nullptr == query)
+        return BK_ERR_SYNTAX;
+
+    std::vector<Element *> matches;
+    query->QueryAll(*document, matches);
+
+    std::string s;
+    for (const Element *element : matches)
+    {
+        for (unsigned i = 0; i < fieldCount; ++i)
+            AppendField(*element, fields[i], s);
+    }
+    BkSetBufferData(dst, s.data(), s.length());
+    return BK_ERR_SUCCESS;
 }
 
 std::string CrawlerImpl::GetConfig(int cfg) const
@@ -66,11 +283,114 @@ std::string CrawlerImpl::GetConfig(int cfg) const
     return ret;
 }
 
+uint64_t CrawlerImpl::GetLimitConfig(int cfg) const
+{
+    std::string limit = GetConfig(cfg);
+    if (limit.empty())
+        return 0;
+    return strtoull(limit.c_str(), nullptr, 10);
+}
+
+void CrawlerImpl::GetTiming(BkCrawlTiming *dst) const
+{
+    size_t size = sizeof(BkCrawlTiming);
+    if (dst->SizeOfStruct < size)
+        size = dst->SizeOfStruct;
+    memcpy(dst, &m_timing, size);
+}
+
 BkJSContext CrawlerImpl::GetScriptContext(void)
 {
     return &(m_frame->GetScriptController().EnsureContext());
 }
 
+int CrawlerImpl::GetVisibleText(BkBuffer *dst)
+{
+    Document *document = m_frame->GetDocument();
+    if (nullptr == document)
+        return BK_ERR_NOT_FOUND;
+
+    std::string text;
+    if (Node *body = document->body())
+        AppendVisibleTextUTF8(text, *body);
+    BkSetBufferData(dst, text.data(), text.length());
+    return BK_ERR_SUCCESS;
+}
+
+unsigned CrawlerImpl::SpeculativePreloadLimit(void) const
+{
+    // Scripts found ahead of the parser are fetched at most this many at a
+    // time, per page. 0 turns speculative fetching off.
+    const unsigned DefaultLimit = 6;
+
+    std::string limit = GetConfig(BK_CFG_PRELOAD_LIMIT);
+    if (limit.empty())
+        return DefaultLimit;
+    return strtoul(limit.c_str(), nullptr, 10);
+}
+
+int CrawlerImpl::SerializeDocument(BkBuffer *dst)
+{
+    Document *document = m_frame->GetDocument();
+    if (nullptr == document)
+        return BK_ERR_NOT_FOUND;
+
+    std::string html;
+    AppendMarkupUTF8(html, *document);
+    BkSetBufferData(dst, html.data(), html.length());
+    return BK_ERR_SUCCESS;
+}
+
+int CrawlerImpl::WriteDocument(BkDataWriter writer, void *userData)
+{
+    Document *document = m_frame->GetDocument();
+    if (nullptr == document)
+        return BK_ERR_NOT_FOUND;
+
+    UTF8MarkupWriter::Sink sink = [writer, userData](const char *data, size_t length) {
+        writer(data, length, userData);
+    };
+    UTF8MarkupWriter(sink).Serialize(*document);
+    return BK_ERR_SUCCESS;
+}
+
+int CrawlerImpl::QuerySelectorsAll(const char *const *selectors, unsigned count, BkBuffer *const *results)
+{
+    if (0 != count && (nullptr == selectors || nullptr == results))
+        return BK_ERR_RANGE;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        if (nullptr == selectors[i] || nullptr == results[i])
+            return BK_ERR_RANGE;
+    }
+
+    Document *document = m_frame->GetDocument();
+    if (nullptr == document)
+        return BK_ERR_NOT_FOUND;
+
+    std::vector<AtomicString> selectorList;
+    selectorList.reserve(count);
+    for (unsigned i = 0; i < count; ++i)
+        selectorList.emplace_back(AtomicString::FromUTF8(selectors[i]));
+
+    TrackExceptionState exceptionState;
+    std::unique_ptr<MultiSelectorQuery> query = MultiSelectorQuery::Create(selectorList, *document, exceptionState);
+    if (!query)
+        return BK_ERR_SYNTAX;
+
+    const BkExtractField outerHTML = { BK_EXTRACT_OUTER_HTML, nullptr };
+
+    std::vector<std::vector<Element *>> matches = query->QueryAll(*document);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        std::string s;
+        for (const Element *element : matches[i])
+            AppendField(*element, outerHTML, s);
+        BkSetBufferData(results[i], s.data(), s.length());
+    }
+    return BK_ERR_SUCCESS;
+}
+
 bool CrawlerImpl::HijackRequest(const char *URL, std::string &dst) const
 {
     if (nullptr == m_client.HijackRequest)
@@ -124,6 +444,26 @@ int BKAPI CrawlerImpl::RegisterCrawlerFunction(const char *name, BkCallback &fun
 }
 #endif // 0
 
+void CrawlerImpl::Reset(void)
+{
+    // The frame and the script heap are kept, but nothing of the previous page: its loaders are cancelled along with
+    // its fetcher, which belongs to the document loader, and whatever of its transfers still comes back is dropped.
+    // Its document and globals are replaced when the next one commits.
+    m_frame->Loader().StopAllLoaders();
+    AbortTransfers();
+    m_frame->GetGCPool().CollectGarbage();
+    m_loadPolicy.reset();
+    m_used = false;
+    m_stopped = false;
+    m_stopTask.reset();
+    m_subresources = 0;
+    m_receivedBytes = 0;
+    m_truncated = false;
+    m_deadlineTask.reset();
+    memset(&m_timing, 0, sizeof(BkCrawlTiming));
+    m_timing.SizeOfStruct = sizeof(BkCrawlTiming);
+}
+
 int CrawlerImpl::Run(const char *URL)
 {
     BkURL u(URL);
@@ -133,6 +473,17 @@ int CrawlerImpl::Run(const char *URL)
         return BK_ERR_URI;
     }
 
+    if (m_used)
+        Reset();
+    m_used = true;
+
+    m_loadPolicy = LoadPolicy::Parse(GetConfig(BK_CFG_LOAD_POLICY));
+    m_limits.timeInMs = GetLimitConfig(BK_CFG_TIME_LIMIT);
+    m_limits.subresources = static_cast<unsigned>(GetLimitConfig(BK_CFG_SUBRESOURCE_LIMIT));
+    m_limits.bytes = GetLimitConfig(BK_CFG_BYTE_LIMIT);
+    if (0 != m_limits.timeInMs)
+        ArmDeadline();
+
     FrameLoadRequest request(nullptr, ResourceRequest(u));
     request.GetResourceRequest().SetCrawler(this);
     request.GetResourceRequest().SetHijackType(HijackType::kMainHTML);
@@ -145,6 +496,39 @@ void CrawlerImpl::TransitionToCommittedForNewPage(void)
     // Nothing to do for crawlers.
 }
 
+void CrawlerImpl::StopLoadingLater(void)
+{
+    // Called back from inside the parser & the loader, which cannot be stopped right here.
+    m_stopped = true;
+    m_stopTask = std::make_shared<CrawlerImpl *>(this);
+
+    std::weak_ptr<CrawlerImpl *> task = m_stopTask;
+    std::function<void()> callback = [task] {
+        if (std::shared_ptr<CrawlerImpl *> crawler = task.lock())
+        {
+            CrawlerImpl *This = *crawler;
+            This->m_stopTask.reset();
+            // Blink cancels its loaders, and the transfers underneath are aborted to spare the network.
+            This->m_frame->Loader().StopAllLoaders();
+            This->AbortTransfers();
+        }
+    };
+    m_frame->GetTaskRunner(TaskType::kNetworking)->PostTask(FROM_HERE, callback);
+}
+
+void CrawlerImpl::Truncate(const char *reason)
+{
+    if (m_truncated)
+        return;
+
+    BKLOG("Crawl truncated: %s.", reason);
+    m_truncated = true;
+    m_deadlineTask.reset();
+
+    // The page goes on as if the aborted resources were unavailable.
+    AbortTransfers();
+}
+
 String CrawlerImpl::UserAgent(void)
 {
     if (nullptr != m_client.GetConfig)
@@ -176,11 +560,53 @@ BKEXPORT BkJSContext BKAPI BkGetScriptContextFromCrawler(BkCrawler crawler)
     return crawler->GetScriptContext();
 }
 
+BKEXPORT int BKAPI BkQuerySelectorsAll(BkCrawler crawler, const char *const *selectors, unsigned count,
+    BkBuffer *const *results)
+{
+    return crawler->QuerySelectorsAll(selectors, count, results);
+}
+
+BKEXPORT int BKAPI BkExtractElements(BkCrawler crawler, const char *selector, const BkExtractField *fields,
+    unsigned fieldCount, BkBuffer *dst)
+{
+    return crawler->ExtractElements(selector, fields, fieldCount, dst);
+}
+
+BKEXPORT int BKAPI BkGetVisibleText(BkCrawler crawler, BkBuffer *dst)
+{
+    return crawler->GetVisibleText(dst);
+}
+
+BKEXPORT void BKAPI BkGetCrawlTiming(BkCrawler crawler, BkCrawlTiming *timing)
+{
+    crawler->GetTiming(timing);
+}
+
+BKEXPORT bool_t BKAPI BkIsCrawlTruncated(BkCrawler crawler)
+{
+    return crawler->IsTruncated();
+}
+
 BKEXPORT void BKAPI BkHijackResponse(BkResponse response, const void *newBody, size_t length)
 {
     response->Hijack(newBody, length);
 }
 
+BKEXPORT int BKAPI BkSerializeDocument(BkCrawler crawler, BkBuffer *dst)
+{
+    return crawler->SerializeDocument(dst);
+}
+
+BKEXPORT int BKAPI BkWriteDocument(BkCrawler crawler, BkDataWriter writer, void *userData)
+{
+    return crawler->WriteDocument(writer, userData);
+}
+
+BKEXPORT void BKAPI BkResetCrawler(BkCrawler crawler)
+{
+    crawler->Reset();
+}
+
 BKEXPORT int BKAPI BkRunCrawler(BkCrawler crawler, const char *URL)
 {
     return crawler->Run(URL);
@@ -15,8 +15,17 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <optional>
 #include "bk_crawler.h"
+#include "bk_http.h"
 #include "blinkit/blink_impl/local_frame_client_impl.h"
+#include "blinkit/crawler/load_policy.h"
+
+namespace BlinKit {
+class HTTPLoaderTask;
+struct TransferSet;
+}
 
 class CrawlerImpl final : public BlinKit::LocalFrameClientImpl
 {
@@ -26,16 +35,35 @@ public:
 
     // BkCrawlerClient Wrappers
     std::string GetConfig(int cfg) const;
+    unsigned SpeculativePreloadLimit(void) const;
     void ProcessRequestComplete(BkResponse response, BkWorkController controller);
     bool HijackRequest(const char *URL, std::string &dst) const;
     void HijackResponse(BkResponse response);
+    bool CanHijackResponse(void) const { return nullptr != m_client.HijackResponse; }
+    bool AllowsLoad(blink::ResourceType type, const BlinKit::BkURL &url);
     bool ApplyConsoleMessager(std::function<void(int, const char *)> &dst) const;
     void ProcessDocumentReset(void);
 
+    // Transfers in flight are tracked to be aborted if the crawl gets truncated. Returns the set, which the task
+    // detaches itself from.
+    const std::shared_ptr<BlinKit::TransferSet>& AttachTransfer(BlinKit::HTTPLoaderTask *task);
+    void CountReceivedBytes(size_t bytes);
+    // What is left of the byte limit, nullopt if there is no limit.
+    std::optional<uint64_t> RemainingBytes(void) const;
+    void CountTransfer(const BkResponseTiming &timing);
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Exports
     int Run(const char *URL);
+    void Reset(void);
+    bool IsTruncated(void) const { return m_truncated; }
+    void GetTiming(BkCrawlTiming *dst) const;
     BkJSContext GetScriptContext(void);
+    int ExtractElements(const char *selector, const BkExtractField *fields, unsigned fieldCount, BkBuffer *dst);
+    int GetVisibleText(BkBuffer *dst);
+    int QuerySelectorsAll(const char *const *selectors, unsigned count, BkBuffer *const *results);
+    int SerializeDocument(BkBuffer *dst);
+    int WriteDocument(BkDataWriter writer, void *userData);
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #if 0 // BKTODO:
@@ -55,10 +83,39 @@ private:
     void TransitionToCommittedForNewPage(void) override;
     void DispatchDidReceiveTitle(const String &title) override {}
     void DispatchDidFailProvisionalLoad(const blink::ResourceError &error) override;
+    void DispatchDidFailLoad(const blink::ResourceError &error) override;
+    void DispatchDidParseDocument(void) override;
+    void DispatchDidFinishDocumentLoad(void) override;
     void DispatchDidFinishLoad(void) override;
 
+    void StopLoadingLater(void);
+    void AbortTransfers(void);
+    uint64_t GetLimitConfig(int cfg) const;
+    void ArmDeadline(void);
+    void Truncate(const char *reason);
+
     BkCrawlerClient m_client;
     std::unique_ptr<blink::LocalFrame> m_frame;
+    std::unique_ptr<BlinKit::LoadPolicy> m_loadPolicy;
+    bool m_used = false;
+    // Set when the client has got what it wants before the page is complete.
+    bool m_stopped = false;
+    // Alive while a task to stop the loads is posted.
+    std::shared_ptr<CrawlerImpl *> m_stopTask;
+
+    // Limits of the current crawl, 0 for none.
+    struct Limits {
+        uint64_t timeInMs = 0;
+        unsigned subresources = 0;
+        uint64_t bytes = 0;
+    } m_limits;
+    unsigned m_subresources = 0;
+    uint64_t m_receivedBytes = 0;
+    bool m_truncated = false;
+    // Alive while the deadline of the crawl is armed.
+    std::shared_ptr<CrawlerImpl *> m_deadlineTask;
+    const std::shared_ptr<BlinKit::TransferSet> m_transfers;
+    BkCrawlTiming m_timing;
 };
 
 DEFINE_TYPE_CASTS(CrawlerImpl, ::blink::LocalFrameClient, client, client->IsCrawler(), client.IsCrawler());
@@ -0,0 +1,232 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: load_policy.cpp
+// Description: LoadPolicy Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "load_policy.h"
+
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "blinkit/common/bk_url.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource.h"
+
+using namespace blink;
+
+namespace BlinKit {
+
+bool LoadPolicy::Allows(ResourceType type, const BkURL &url) const
+{
+    if (ResourceType::kMainResource == type)
+        return true;
+
+    std::string MIMEType;
+    bool MIMETypeGuessed = false;
+    for (const Rule &rule : m_rules)
+    {
+        std::string subject;
+        switch (rule.field)
+        {
+            case Field::Type:
+                subject = TypeName(type);
+                break;
+            case Field::MIME:
+                if (!MIMETypeGuessed)
+                {
+                    MIMEType = GuessMIMEType(url);
+                    MIMETypeGuessed = true;
+                }
+                subject = MIMEType;
+                break;
+            case Field::URL:
+                subject = url.AsString();
+                break;
+        }
+        if (subject.empty())
+            continue;
+
+        for (const std::string &pattern : rule.patterns)
+        {
+            if (Match(pattern.c_str(), subject.c_str()))
+                return rule.allow;
+        }
+    }
+    return true;
+}
+
+std::string LoadPolicy::GuessMIMEType(const BkURL &url)
+{
+    // The type is not known before the response arrives, so it is guessed by
+    // the extension, which is what matters for the trackers and media files.
+    static const struct {
+        const char *extension;
+        const char *MIMEType;
+    } KnownTypes[] = {
+        { "avif",  "image/avif"             },
+        { "bmp",   "image/bmp"              },
+        { "css",   "text/css"               },
+        { "eot",   "application/vnd.ms-fontobject" },
+        { "gif",   "image/gif"              },
+        { "htm",   "text/html"              },
+        { "html",  "text/html"              },
+        { "ico",   "image/x-icon"           },
+        { "jpeg",  "image/jpeg"             },
+        { "jpg",   "image/jpeg"             },
+        { "js",    "application/javascript" },
+        { "json",  "application/json"       },
+        { "m4a",   "audio/mp4"              },
+        { "mjs",   "application/javascript" },
+        { "mp3",   "audio/mpeg"             },
+        { "mp4",   "video/mp4"              },
+        { "oga",   "audio/ogg"              },
+        { "ogg",   "audio/ogg"              },
+        { "ogv",   "video/ogg"              },
+        { "otf",   "font/otf"               },
+        { "png",   "image/png"              },
+        { "svg",   "image/svg+xml"          },
+        { "ttf",   "font/ttf"               },
+        { "vtt",   "text/vtt"               },
+        { "wav",   "audio/wav"              },
+        { "webm",  "video/webm"             },
+        { "webp",  "image/webp"             },
+        { "woff",  "font/woff"              },
+        { "woff2", "font/woff2"             },
+        { "xml",   "text/xml"               }
+    };
+
+    const std::string path = url.Path();
+    size_t p = path.find_last_of("./");
+    if (std::string::npos == p || '.' != path.at(p))
+        return std::string();
+
+    const std::string extension = base::ToLowerASCII(path.substr(p + 1));
+    for (const auto &it : KnownTypes)
+    {
+        if (extension == it.extension)
+            return it.MIMEType;
+    }
+    return std::string();
+}
+
+bool LoadPolicy::Match(const char *pattern, const char *s)
+{
+    // Glob matching with '*' only, backtracking to the last star.
+    const char *star = nullptr, *resume = nullptr;
+    while ('\0' != *s)
+    {
+        if ('*' == *pattern)
+        {
+            star = pattern++;
+            resume = s;
+        }
+        else if (*pattern == *s)
+        {
+            ++pattern;
+            ++s;
+        }
+        else if (nullptr != star)
+        {
+            pattern = star + 1;
+            s = ++resume;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while ('*' == *pattern)
+        ++pattern;
+    return '\0' == *pattern;
+}
+
+std::unique_ptr<LoadPolicy> LoadPolicy::Parse(const std::string &rules)
+{
+    std::unique_ptr<LoadPolicy> ret(new LoadPolicy);
+    for (const std::string &line : base::SplitString(rules, ";\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY))
+    {
+        Rule rule;
+
+        size_t p = line.find_first_of(" \t");
+        const std::string action = line.substr(0, p);
+        if ("allow" == action)
+            rule.allow = true;
+        else if ("deny" == action)
+            rule.allow = false;
+        else
+            p = std::string::npos;
+
+        size_t colon = std::string::npos != p ? line.find(':', p) : std::string::npos;
+        if (std::string::npos == colon)
+        {
+            BKLOG("Invalid load policy rule: %s", line.c_str());
+            continue;
+        }
+
+        const std::string field = base::ToLowerASCII(base::TrimWhitespaceASCII(line.substr(p, colon - p), base::TRIM_ALL));
+        std::string patterns = line.substr(colon + 1);
+        if ("type" == field)
+        {
+            rule.field = Field::Type;
+            patterns = base::ToLowerASCII(patterns);
+        }
+        else if ("mime" == field)
+        {
+            rule.field = Field::MIME;
+            patterns = base::ToLowerASCII(patterns);
+        }
+        else if ("url" == field)
+        {
+            rule.field = Field::URL;
+        }
+        else
+        {
+            BKLOG("Invalid load policy rule: %s", line.c_str());
+            continue;
+        }
+
+        rule.patterns = base::SplitString(patterns, ", ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+        if (!rule.patterns.empty())
+            ret->m_rules.emplace_back(std::move(rule));
+    }
+
+    if (ret->m_rules.empty())
+        return nullptr;
+    return ret;
+}
+
+const char* LoadPolicy::TypeName(ResourceType type)
+{
+    switch (type)
+    {
+        case ResourceType::kMainResource:
+            return "document";
+        case ResourceType::kImage:
+            return "image";
+        case ResourceType::kCSSStyleSheet:
+        case ResourceType::kXSLStyleSheet:
+            return "stylesheet";
+        case ResourceType::kScript:
+        case ResourceType::kImportResource:
+            return "script";
+        case ResourceType::kFont:
+            return "font";
+        case ResourceType::kLinkPrefetch:
+            return "prefetch";
+        case ResourceType::kTextTrack:
+        case ResourceType::kAudio:
+        case ResourceType::kVideo:
+            return "media";
+        case ResourceType::kManifest:
+            return "manifest";
+        case ResourceType::kRaw:
+            return "xhr";
+    }
+    return "other";
+}
+
+} // namespace BlinKit
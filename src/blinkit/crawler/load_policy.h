@@ -0,0 +1,58 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: load_policy.h
+// Description: LoadPolicy Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINKIT_LOAD_POLICY_H
+#define BLINKIT_BLINKIT_LOAD_POLICY_H
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace blink {
+enum class ResourceType : uint8_t;
+}
+
+namespace BlinKit {
+
+class BkURL;
+
+// Decides which subresources a crawler fetches, see BK_CFG_LOAD_POLICY for the
+// syntax. Rules are tried in order and the first match wins, loads matching no
+// rule are allowed. Main documents are always allowed.
+class LoadPolicy
+{
+public:
+    // Returns nullptr if there is no rule at all.
+    static std::unique_ptr<LoadPolicy> Parse(const std::string &rules);
+
+    bool Allows(blink::ResourceType type, const BkURL &url) const;
+private:
+    LoadPolicy(void) = default;
+
+    enum class Field { Type, MIME, URL };
+    struct Rule {
+        bool allow;
+        Field field;
+        std::vector<std::string> patterns;
+    };
+
+    static const char* TypeName(blink::ResourceType type);
+    static std::string GuessMIMEType(const BkURL &url);
+    static bool Match(const char *pattern, const char *s);
+
+    std::vector<Rule> m_rules;
+};
+
+} // namespace BlinKit
+
+#endif // BLINKIT_BLINKIT_LOAD_POLICY_H
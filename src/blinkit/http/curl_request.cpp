@@ -38,7 +38,8 @@ CURLRequest::~CURLRequest(void)
 
 void CURLRequest::Cancel(void)
 {
-    assert(false); // BKTODO:
+    // Picked up by ProgressCallback, which curl calls at least once a second, even while the transfer is stalled.
+    m_cancelled = true;
 }
 
 static size_t HeaderCallback(char *buffer, size_t, size_t nitems, void *userData)
@@ -58,8 +59,17 @@ void* CURLRequest::DoThreadWork(void)
     if (CURLE_OK == code)
     {
         m_response->ParseHeaders(headers);
+
+        BkResponseTiming timing = m_response->Timing();
+        FillTiming(timing);
+        m_response->SetTiming(timing);
+
         m_client.RequestComplete(m_response.get(), m_client.UserData);
     }
+    else if (CURLE_ABORTED_BY_CALLBACK == code)
+    {
+        m_client.RequestFailed(m_overByteLimit ? BK_ERR_RANGE : BK_ERR_CANCELLED, m_client.UserData);
+    }
     else
     {
         BKLOG("ERROR: curl_easy_perform failed, code = %d.", code);
@@ -70,10 +80,53 @@ void* CURLRequest::DoThreadWork(void)
     return nullptr;
 }
 
-ControllerImpl* CURLRequest::GetController(void)
+void CURLRequest::FillTiming(BkResponseTiming &timing) const
 {
-    assert(false); // BKTODO:
-    return nullptr;
+    auto milliseconds = [this](CURLINFO info) {
+        curl_off_t us = 0;
+        curl_easy_getinfo(m_curl, info, &us);
+        return static_cast<double>(us) / 1000;
+    };
+    timing.NameLookup = milliseconds(CURLINFO_NAMELOOKUP_TIME_T);
+    timing.Connect = milliseconds(CURLINFO_CONNECT_TIME_T);
+    timing.TLSHandshake = milliseconds(CURLINFO_APPCONNECT_TIME_T);
+    timing.FirstByte = milliseconds(CURLINFO_STARTTRANSFER_TIME_T);
+    timing.Total = milliseconds(CURLINFO_TOTAL_TIME_T);
+
+    long l = 0;
+    curl_easy_getinfo(m_curl, CURLINFO_REQUEST_SIZE, &l);
+    timing.RequestBytes = l;
+    l = 0;
+    curl_easy_getinfo(m_curl, CURLINFO_HEADER_SIZE, &l);
+    timing.HeaderBytes = l;
+    curl_off_t bodyBytes = 0;
+    curl_easy_getinfo(m_curl, CURLINFO_SIZE_DOWNLOAD_T, &bodyBytes);
+    timing.BodyBytes = bodyBytes;
+
+    // No new connection made for the transfer.
+    l = 0;
+    curl_easy_getinfo(m_curl, CURLINFO_NUM_CONNECTS, &l);
+    timing.ConnectionReused = 0 == l;
+
+    l = CURL_HTTP_VERSION_NONE;
+    curl_easy_getinfo(m_curl, CURLINFO_HTTP_VERSION, &l);
+    switch (l)
+    {
+        case CURL_HTTP_VERSION_1_0:
+            timing.HTTPVersion = 10;
+            break;
+        case CURL_HTTP_VERSION_1_1:
+            timing.HTTPVersion = 11;
+            break;
+        case CURL_HTTP_VERSION_2_0:
+            timing.HTTPVersion = 20;
+            break;
+        case CURL_HTTP_VERSION_3:
+            timing.HTTPVersion = 30;
+            break;
+        default:
+            timing.HTTPVersion = 0;
+    }
 }
 
 int CURLRequest::Perform(void)
@@ -123,15 +176,33 @@ int CURLRequest::Perform(void)
         m_response = std::make_unique<ResponseImpl>(m_URL);
         curl_easy_setopt(m_curl, CURLOPT_WRITEDATA, m_response.get());
         curl_easy_setopt(m_curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(m_curl, CURLOPT_XFERINFODATA, this);
+        curl_easy_setopt(m_curl, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+        curl_easy_setopt(m_curl, CURLOPT_NOPROGRESS, OPT_FALSE);
         if (0 == pthread_create(&m_thread, nullptr, ThreadProc, this))
             return BK_ERR_SUCCESS;
     } while (false);
 
     assert(BK_ERR_SUCCESS == err);
-    delete this;
+    // A controller taken before may still hold the request.
+    RequestImpl::Release();
     return err;
 }
 
+int CURLRequest::ProgressCallback(void *clientData, curl_off_t, curl_off_t dlnow, curl_off_t, curl_off_t)
+{
+    CURLRequest *This = reinterpret_cast<CURLRequest *>(clientData);
+    if (This->m_cancelled)
+        return 1;
+    if (This->IsOverByteLimit(static_cast<uint64_t>(dlnow)))
+    {
+        // Stop downloading right away, instead of finding out after the whole body arrives.
+        This->m_overByteLimit = true;
+        return 1;
+    }
+    return 0;
+}
+
 void* CURLRequest::ThreadProc(void *arg)
 {
     CURLRequest *This = reinterpret_cast<CURLRequest *>(arg);
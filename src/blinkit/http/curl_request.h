@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <pthread.h>
 #include <curl/curl.h>
 #include <curl/easy.h>
@@ -29,17 +30,20 @@ public:
 private:
     static CURLoption TranslateOption(const std::string &name);
     void* DoThreadWork(void);
+    void FillTiming(BkResponseTiming &timing) const;
+    static int ProgressCallback(void *clientData, curl_off_t, curl_off_t, curl_off_t, curl_off_t);
     static void* ThreadProc(void *arg);
     static size_t WriteCallback(char *ptr, size_t, size_t nmemb, void *userData);
 
     // RequestImpl
     int Perform(void) override;
-    ControllerImpl* GetController(void) override;
     void Cancel(void) override;
 
     CURL *m_curl;
     pthread_t m_thread = 0;
     curl_slist *m_headersList = nullptr;
+    std::atomic<bool> m_cancelled{ false };
+    bool m_overByteLimit = false; // Only touched by the transfer thread.
 };
 
 } // namespace BlinKit
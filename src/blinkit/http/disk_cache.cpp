@@ -0,0 +1,426 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: disk_cache.cpp
+// Description: DiskCache Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "disk_cache.h"
+
+#include <atomic>
+#include "base/strings/string_util.h"
+#include "blinkit/app/app_impl.h"
+#include "blinkit/common/bk_http_header_map.h"
+#include "blinkit/http/response_cache.h"
+#include "blinkit/http/response_impl.h"
+#if OS_WIN
+#   include <direct.h>
+#else
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace BlinKit {
+
+static const char Magic[4] = { 'B', 'K', 'D', 'C' };
+static const uint32_t Version = 2;
+static const size_t RecordHeaderSize = 48;
+
+namespace {
+
+uint64_t Hash(const void *data, size_t size)
+{
+    // 64-bit FNV-1a.
+    uint64_t h = 0xcbf29ce484222325ULL;
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+std::string HashToString(uint64_t hash)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+    return buf;
+}
+
+void MakeDirectory(const std::string &path)
+{
+#if OS_WIN
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+}
+
+bool ReadFile(const std::string &path, std::string &dst)
+{
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (nullptr == fp)
+        return false;
+
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+        dst.append(buf, n);
+    fclose(fp);
+    return true;
+}
+
+void WriteU32(std::string &dst, uint32_t n)
+{
+    for (int i = 0; i < 4; ++i)
+        dst.push_back(static_cast<char>((n >> (i * 8)) & 0xff));
+}
+
+void WriteU64(std::string &dst, uint64_t n)
+{
+    WriteU32(dst, static_cast<uint32_t>(n));
+    WriteU32(dst, static_cast<uint32_t>(n >> 32));
+}
+
+void WriteString(std::string &dst, const std::string &s)
+{
+    WriteU32(dst, static_cast<uint32_t>(s.length()));
+    dst.append(s);
+}
+
+class Reader
+{
+public:
+    explicit Reader(const std::string &data) : m_p(data.data()), m_end(data.data() + data.length()) {}
+
+    bool ReadU32(uint32_t &ret)
+    {
+        if (m_end - m_p < 4)
+            return false;
+        const uint8_t *b = reinterpret_cast<const uint8_t *>(m_p);
+        ret = b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<uint32_t>(b[3]) << 24);
+        m_p += 4;
+        return true;
+    }
+
+    bool ReadU64(uint64_t &ret)
+    {
+        uint32_t lo, hi;
+        if (!ReadU32(lo) || !ReadU32(hi))
+            return false;
+        ret = (static_cast<uint64_t>(hi) << 32) | lo;
+        return true;
+    }
+
+    bool ReadString(std::string &ret)
+    {
+        uint32_t length;
+        if (!ReadU32(length) || static_cast<size_t>(m_end - m_p) < length)
+            return false;
+        ret.assign(m_p, length);
+        m_p += length;
+        return true;
+    }
+
+    bool Skip(size_t n)
+    {
+        if (static_cast<size_t>(m_end - m_p) < n)
+            return false;
+        m_p += n;
+        return true;
+    }
+private:
+    const char *m_p;
+    const char *m_end;
+};
+
+} // namespace
+
+bool DiskCache::Entry::AddValidators(BkHTTPHeaderMap &requestHeaders) const
+{
+    bool ret = false;
+
+    const std::string ETag = m_response->Headers().Get("ETag");
+    if (!ETag.empty())
+    {
+        requestHeaders.Set("If-None-Match", ETag);
+        ret = true;
+    }
+
+    const std::string lastModified = m_response->Headers().Get("Last-Modified");
+    if (!lastModified.empty())
+    {
+        requestHeaders.Set("If-Modified-Since", lastModified);
+        ret = true;
+    }
+
+    return ret;
+}
+
+std::string DiskCache::BlobPath(const std::string &URL, uint64_t bodyHash, size_t bodySize) const
+{
+    std::string name = HashToString(Hash(URL.data(), URL.length()));
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), "-%016llx-%llx", static_cast<unsigned long long>(bodyHash),
+        static_cast<unsigned long long>(bodySize));
+    return m_root + "/blobs/" + name.substr(0, 2) + '/' + name + suffix;
+}
+
+bool DiskCache::Entry::IsFresh(void) const
+{
+    return base::Time::Now() < m_responseTime + m_lifetime;
+}
+
+std::unique_ptr<DiskCache::Entry> DiskCache::Load(const std::string &URL, const BkHTTPHeaderMap &requestHeaders) const
+{
+    std::string record;
+    if (!ReadFile(RecordPath(URL), record))
+        return nullptr;
+
+    if (record.length() < RecordHeaderSize || 0 != memcmp(record.data(), Magic, sizeof(Magic)))
+        return nullptr;
+
+    Reader reader(record);
+    reader.Skip(sizeof(Magic));
+
+    uint32_t version, statusCode, headerCount;
+    uint64_t responseTime, lifetime, bodyHash, bodySize;
+    if (!reader.ReadU32(version) || Version != version)
+        return nullptr;
+    if (!reader.ReadU32(statusCode) || !reader.ReadU32(headerCount) || !reader.ReadU64(responseTime)
+        || !reader.ReadU64(lifetime) || !reader.ReadU64(bodyHash) || !reader.ReadU64(bodySize))
+    {
+        return nullptr;
+    }
+
+    std::string storedURL;
+    if (!reader.ReadString(storedURL) || storedURL != URL)
+        return nullptr; // Hash collision.
+
+    std::unique_ptr<Entry> ret(new Entry);
+    ret->m_response = std::make_shared<ResponseImpl>(URL);
+    ret->m_response->SetStatusCode(statusCode);
+    for (uint32_t i = 0; i < headerCount; ++i)
+    {
+        std::string name, value;
+        if (!reader.ReadString(name) || !reader.ReadString(value))
+            return nullptr;
+        ret->m_response->MutableHeaders().Set(name, value);
+    }
+
+    uint32_t varyCount;
+    if (!reader.ReadU32(varyCount))
+        return nullptr;
+    for (uint32_t i = 0; i < varyCount; ++i)
+    {
+        std::string name, value;
+        if (!reader.ReadString(name) || !reader.ReadString(value))
+            return nullptr;
+        if (requestHeaders.Get(name) != value)
+            return nullptr;
+    }
+
+    std::string body;
+    if (!ReadFile(BlobPath(URL, bodyHash, bodySize), body) || body.length() != bodySize)
+        return nullptr;
+    if (Hash(body.data(), body.length()) != bodyHash)
+    {
+        BKLOG("Corrupted cache body: %s", URL.c_str());
+        return nullptr;
+    }
+    ret->m_response->PrepareBody(body.length());
+    ret->m_response->AppendData(body.data(), body.length());
+
+    ret->m_responseTime = base::Time() + base::TimeDelta::FromMicroseconds(static_cast<int64_t>(responseTime));
+    ret->m_lifetime = base::TimeDelta::FromMicroseconds(static_cast<int64_t>(lifetime));
+    ret->m_bodyHash = bodyHash;
+    return ret;
+}
+
+std::unique_ptr<DiskCache> DiskCache::Open(const std::string &root)
+{
+    if (root.empty())
+        return nullptr;
+
+    MakeDirectory(root);
+    MakeDirectory(root + "/index");
+    MakeDirectory(root + "/blobs");
+    return std::unique_ptr<DiskCache>(new DiskCache(root));
+}
+
+bool DiskCache::ReadBodyKey(const std::string &URL, uint64_t &bodyHash, uint64_t &bodySize) const
+{
+    std::string record;
+    if (!ReadFile(RecordPath(URL), record))
+        return false;
+
+    if (record.length() < RecordHeaderSize || 0 != memcmp(record.data(), Magic, sizeof(Magic)))
+        return false;
+
+    Reader reader(record);
+    reader.Skip(sizeof(Magic));
+
+    uint32_t version;
+    if (!reader.ReadU32(version) || Version != version)
+        return false;
+    reader.Skip(2 * sizeof(uint32_t) + 2 * sizeof(uint64_t)); // Status code, header count, time & lifetime.
+    return reader.ReadU64(bodyHash) && reader.ReadU64(bodySize);
+}
+
+std::string DiskCache::RecordPath(const std::string &URL) const
+{
+    std::string name = HashToString(Hash(URL.data(), URL.length()));
+    return m_root + "/index/" + name.substr(0, 2) + '/' + name;
+}
+
+std::shared_ptr<ResponseImpl> DiskCache::Revalidate(
+    const std::string &URL, const BkHTTPHeaderMap &requestHeaders, Entry &entry, const ResponseImpl &notModified)
+{
+    std::shared_ptr<ResponseImpl> response = entry.TakeResponse();
+
+    // RFC 7234, 4.3.4: Update the stored headers with the ones in the 304 response, except the ones which describe
+    // the body.
+    for (const auto &it : notModified.Headers().GetRawMap())
+    {
+        if (base::EqualsCaseInsensitiveASCII(it.first, "Content-Length")
+            || base::EqualsCaseInsensitiveASCII(it.first, "Content-Encoding")
+            || base::EqualsCaseInsensitiveASCII(it.first, "Transfer-Encoding"))
+        {
+            continue;
+        }
+        response->MutableHeaders().Set(it.first, it.second);
+    }
+    response->SetTiming(notModified.Timing());
+
+    ResponseCache::VaryValues vary;
+    if (ResponseCache::GetVaryValues(*response, requestHeaders, vary))
+        WriteRecord(URL, vary, *response, base::Time::Now(), ResponseCache::FreshnessLifetime(*response), entry.m_bodyHash);
+    else
+    {
+        // "Vary: *" now, which matches no later request.
+        remove(RecordPath(URL).c_str());
+        remove(BlobPath(URL, entry.m_bodyHash, response->BodyLength()).c_str());
+    }
+    return response;
+}
+
+void DiskCache::Store(const std::string &URL, const BkHTTPHeaderMap &requestHeaders, const ResponseImpl &response)
+{
+    if (!ResponseCache::IsStorable(response) || !ResponseCache::IsSharable(requestHeaders, response))
+        return;
+
+    const base::TimeDelta lifetime = ResponseCache::FreshnessLifetime(response);
+    if (lifetime.is_zero() && response.Headers().Get("ETag").empty() && response.Headers().Get("Last-Modified").empty())
+        return; // Could be neither reused nor revalidated.
+
+    ResponseCache::VaryValues vary;
+    if (!ResponseCache::GetVaryValues(response, requestHeaders, vary))
+        return;
+
+    const size_t bodySize = response.BodyLength();
+    const uint64_t bodyHash = Hash(response.BodyData(), bodySize);
+
+    // Always written, as a file left by another process may be truncated or stale.
+    if (!WriteFile(BlobPath(URL, bodyHash, bodySize), response.BodyData(), bodySize))
+        return;
+
+    uint64_t oldHash, oldSize;
+    const bool replacing = ReadBodyKey(URL, oldHash, oldSize);
+    if (!WriteRecord(URL, vary, response, base::Time::Now(), lifetime, bodyHash))
+        return;
+
+    // The old body belongs to no record any more.
+    if (replacing && (oldHash != bodyHash || oldSize != bodySize))
+        remove(BlobPath(URL, oldHash, static_cast<size_t>(oldSize)).c_str());
+}
+
+bool DiskCache::WriteFile(const std::string &path, const void *data, size_t size) const
+{
+    static std::atomic<unsigned> s_sequence{ 0 };
+
+    MakeDirectory(path.substr(0, path.rfind('/')));
+
+    char suffix[64];
+#if OS_WIN
+    const unsigned long pid = GetCurrentProcessId();
+#else
+    const unsigned long pid = getpid();
+#endif
+    snprintf(suffix, sizeof(suffix), ".%lu.%u.tmp", pid, s_sequence.fetch_add(1));
+    const std::string tempPath = path + suffix;
+
+    FILE *fp = fopen(tempPath.c_str(), "wb");
+    if (nullptr == fp)
+        return false;
+
+    bool ok = 0 == size || size == fwrite(data, 1, size, fp);
+    ok = 0 == fclose(fp) && ok;
+    if (ok)
+    {
+#if OS_WIN
+        ok = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+        ok = 0 == rename(tempPath.c_str(), path.c_str());
+#endif
+    }
+    if (!ok)
+    {
+        BKLOG("Write cache file failed: %s", path.c_str());
+        remove(tempPath.c_str());
+    }
+    return ok;
+}
+
+bool DiskCache::WriteRecord(
+    const std::string &URL, const ResponseCache::VaryValues &vary, const ResponseImpl &response,
+    const base::Time &responseTime, const base::TimeDelta &lifetime, uint64_t bodyHash)
+{
+    const auto &headers = response.Headers().GetRawMap();
+
+    std::string record(Magic, sizeof(Magic));
+    WriteU32(record, Version);
+    WriteU32(record, response.StatusCode());
+    WriteU32(record, static_cast<uint32_t>(headers.size()));
+    WriteU64(record, static_cast<uint64_t>(responseTime.since_origin().InMicroseconds()));
+    WriteU64(record, static_cast<uint64_t>(lifetime.InMicroseconds()));
+    WriteU64(record, bodyHash);
+    WriteU64(record, response.BodyLength());
+    ASSERT(RecordHeaderSize == record.length());
+
+    WriteString(record, URL);
+    for (const auto &it : headers)
+    {
+        WriteString(record, it.first);
+        WriteString(record, it.second);
+    }
+    WriteU32(record, static_cast<uint32_t>(vary.size()));
+    for (const auto &it : vary)
+    {
+        WriteString(record, it.first);
+        WriteString(record, it.second);
+    }
+
+    return WriteFile(RecordPath(URL), record.data(), record.length());
+}
+
+} // namespace BlinKit
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace BlinKit;
+
+extern "C" {
+
+BKEXPORT int BKAPI BkSetDiskCacheDirectory(const char *path)
+{
+    if (nullptr == path || '\0' == *path)
+        return BK_ERR_FORBIDDEN;
+    return AppImpl::Get().SetDiskCache(DiskCache::Open(path));
+}
+
+} // extern "C"
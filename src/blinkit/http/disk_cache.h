@@ -0,0 +1,79 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: disk_cache.h
+// Description: DiskCache Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINKIT_DISK_CACHE_H
+#define BLINKIT_BLINKIT_DISK_CACHE_H
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "base/time/time.h"
+#include "blinkit/http/response_cache.h"
+
+class ResponseImpl;
+
+namespace BlinKit {
+
+class BkHTTPHeaderMap;
+
+// HTTP cache on disk (RFC 7234), which survives between crawls:
+//   <root>/index/xx/<URL hash>                     one record per URL: status, headers, freshness, the body hash
+//                                                  and the request header values named by Vary.
+//   <root>/blobs/xx/<URL hash>-<body hash>-<size>  bodies, which belong to the records of their URLs.
+// Records start with a fixed size header, and every file is written to a unique temporary file which is renamed
+// into place, so the cache can be shared by concurrent processes: readers see either the old or the new file.
+// A body is checked against the hash in its record when loaded.
+class DiskCache
+{
+public:
+    static std::unique_ptr<DiskCache> Open(const std::string &root);
+
+    class Entry
+    {
+    public:
+        bool IsFresh(void) const;
+        // Adds If-None-Match / If-Modified-Since, returns false if the entry has no validators.
+        bool AddValidators(BkHTTPHeaderMap &requestHeaders) const;
+
+        std::shared_ptr<ResponseImpl> TakeResponse(void) { return std::move(m_response); }
+    private:
+        friend class DiskCache;
+
+        std::shared_ptr<ResponseImpl> m_response;
+        base::Time m_responseTime;
+        base::TimeDelta m_lifetime;
+        uint64_t m_bodyHash = 0;
+    };
+
+    // Only returns the entry if the request matches the header values it was stored for.
+    std::unique_ptr<Entry> Load(const std::string &URL, const BkHTTPHeaderMap &requestHeaders) const;
+    void Store(const std::string &URL, const BkHTTPHeaderMap &requestHeaders, const ResponseImpl &response);
+    // Merges the headers of a 304 response into the entry, and returns the refreshed response.
+    std::shared_ptr<ResponseImpl> Revalidate(const std::string &URL, const BkHTTPHeaderMap &requestHeaders,
+        Entry &entry, const ResponseImpl &notModified);
+private:
+    DiskCache(const std::string &root) : m_root(root) {}
+
+    std::string RecordPath(const std::string &URL) const;
+    std::string BlobPath(const std::string &URL, uint64_t bodyHash, size_t bodySize) const;
+    bool WriteFile(const std::string &path, const void *data, size_t size) const;
+    // Reads the body key from the header of the current record, returns false if there is no valid one.
+    bool ReadBodyKey(const std::string &URL, uint64_t &bodyHash, uint64_t &bodySize) const;
+    bool WriteRecord(const std::string &URL, const ResponseCache::VaryValues &vary, const ResponseImpl &response,
+        const base::Time &responseTime, const base::TimeDelta &lifetime, uint64_t bodyHash);
+
+    const std::string m_root;
+};
+
+} // namespace BlinKit
+
+#endif // BLINKIT_BLINKIT_DISK_CACHE_H
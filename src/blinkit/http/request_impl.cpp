@@ -67,6 +67,11 @@ BKEXPORT int BKAPI BkPerformRequest(BkRequest request, BkWorkController *control
     return request->Perform();
 }
 
+BKEXPORT void BKAPI BkReleaseRequest(BkRequest request)
+{
+    request->Release();
+}
+
 BKEXPORT void BKAPI BkSetRequestBody(BkRequest request, const void *data, size_t dataLength)
 {
     request->SetBody(data, dataLength);
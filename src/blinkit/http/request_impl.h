@@ -36,6 +36,8 @@ public:
     void SetBody(const void *data, size_t dataLength);
     void SetTimeout(unsigned timeout) { m_timeoutInMs = timeout * 1000; }
     void SetProxy(const char *proxy);
+    // The transfer fails with BK_ERR_RANGE once the body goes over the limit.
+    void SetByteLimit(uint64_t limit) { m_byteLimit = limit; }
     virtual ControllerImpl* GetController(void);
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -51,6 +53,7 @@ protected:
         assert(m_proxy.has_value());
         return *m_proxy;
     }
+    bool IsOverByteLimit(uint64_t bodySize) const { return m_byteLimit.has_value() && bodySize > *m_byteLimit; }
 
     const std::string m_URL;
     BkRequestClient m_client;
@@ -62,6 +65,7 @@ private:
     std::atomic<unsigned> m_refCount{ 1 };
     unsigned long m_timeoutInMs;
     std::optional<std::string> m_proxy;
+    std::optional<uint64_t> m_byteLimit;
 };
 
 #endif // BLINKIT_BLINKIT_REQUEST_IMPL_H
@@ -0,0 +1,245 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: response_cache.cpp
+// Description: ResponseCache Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "response_cache.h"
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "bk_crawler.h"
+#include "blinkit/app/app_impl.h"
+#include "blinkit/common/bk_http_header_map.h"
+#include "blinkit/http/response_impl.h"
+
+namespace BlinKit {
+
+void ResponseCache::EvictIfNecessary(void)
+{
+    while (m_bytes > m_capacity && !m_entries.empty())
+    {
+        const Entry &e = m_entries.back();
+        m_bytes -= e.size;
+        m_index.erase(e.URL);
+        m_entries.pop_back();
+        ++m_evictions;
+    }
+}
+
+base::TimeDelta ResponseCache::FreshnessLifetime(const ResponseImpl &response)
+{
+    const std::string cacheControl = response.Headers().Get("Cache-Control");
+
+    int maxAge = -1, sharedMaxAge = -1;
+    for (const std::string &directive : base::SplitString(cacheControl, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY))
+    {
+        if (base::EqualsCaseInsensitiveASCII(directive, "no-store") || base::EqualsCaseInsensitiveASCII(directive, "no-cache"))
+            return base::TimeDelta();
+        if (base::StartsWith(directive, "max-age=", base::CompareCase::INSENSITIVE_ASCII))
+        {
+            if (!base::StringToInt(directive.substr(8), &maxAge))
+                return base::TimeDelta();
+        }
+        else if (base::StartsWith(directive, "s-maxage=", base::CompareCase::INSENSITIVE_ASCII))
+        {
+            if (!base::StringToInt(directive.substr(9), &sharedMaxAge))
+                return base::TimeDelta();
+        }
+    }
+    if (sharedMaxAge >= 0)
+        maxAge = sharedMaxAge;
+
+    int age = 0;
+    const std::string ageHeader = response.Headers().Get("Age");
+    if (!ageHeader.empty() && !base::StringToInt(ageHeader, &age))
+        age = 0;
+
+    if (maxAge <= age)
+        return base::TimeDelta();
+    return base::TimeDelta::FromSeconds(maxAge - age);
+}
+
+bool ResponseCache::GetVaryValues(const ResponseImpl &response, const BkHTTPHeaderMap &requestHeaders, VaryValues &dst)
+{
+    const std::string vary = response.Headers().Get("Vary");
+    for (const std::string &name : base::SplitString(vary, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY))
+    {
+        if ("*" == name)
+            return false;
+        dst.emplace_back(name, requestHeaders.Get(name));
+    }
+    return true;
+}
+
+void ResponseCache::GetStats(BkResourceCacheStats &stats) const
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    stats.Hits = m_hits;
+    stats.Misses = m_misses;
+    stats.Evictions = m_evictions;
+    stats.Entries = m_index.size();
+    stats.Bytes = m_bytes;
+}
+
+bool ResponseCache::IsStorable(const ResponseImpl &response)
+{
+    if (200 != response.StatusCode() || BK_ERR_SUCCESS != response.ErrorCode())
+        return false;
+    // Responses which set cookies are specific to the crawl which received them.
+    if (!response.Cookies().empty())
+        return false;
+
+    const std::string cacheControl = response.Headers().Get("Cache-Control");
+    for (const std::string &directive : base::SplitString(cacheControl, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY))
+    {
+        if (base::EqualsCaseInsensitiveASCII(directive, "no-store"))
+            return false;
+    }
+    return true;
+}
+
+bool ResponseCache::IsSharable(const BkHTTPHeaderMap &requestHeaders, const ResponseImpl &response)
+{
+    bool isPublic = false;
+
+    const std::string cacheControl = response.Headers().Get("Cache-Control");
+    for (const std::string &directive : base::SplitString(cacheControl, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY))
+    {
+        // private="field" is taken as private as a whole.
+        if (base::EqualsCaseInsensitiveASCII(directive, "private")
+            || base::StartsWith(directive, "private=", base::CompareCase::INSENSITIVE_ASCII))
+        {
+            return false;
+        }
+        if (base::EqualsCaseInsensitiveASCII(directive, "public"))
+            isPublic = true;
+    }
+
+    // The cookies of the jar, or the credentials, may have personalised the response.
+    if (!isPublic && (!requestHeaders.Get("Cookie").empty() || !requestHeaders.Get("Authorization").empty()))
+        return false;
+    return true;
+}
+
+std::shared_ptr<ResponseImpl> ResponseCache::Lookup(const std::string &URL, const BkHTTPHeaderMap &requestHeaders)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    auto it = m_index.find(URL);
+    if (std::end(m_index) == it)
+    {
+        ++m_misses;
+        return nullptr;
+    }
+
+    EntryList::iterator entry = it->second;
+    if (entry->expiry <= base::TimeTicks::Now())
+    {
+        m_bytes -= entry->size;
+        m_entries.erase(entry);
+        m_index.erase(it);
+        ++m_misses;
+        return nullptr;
+    }
+
+    for (const auto &vary : entry->vary)
+    {
+        if (requestHeaders.Get(vary.first) != vary.second)
+        {
+            ++m_misses;
+            return nullptr;
+        }
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+    ++m_hits;
+
+    // Copy out of the lock, the entry is kept alive by the shared pointer.
+    std::shared_ptr<const ResponseImpl> response = entry->response;
+    lock.unlock();
+
+    std::shared_ptr<ResponseImpl> ret = std::make_shared<ResponseImpl>(*response);
+    ret->ClearTiming();
+    return ret;
+}
+
+void ResponseCache::SetCapacity(size_t capacity)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_capacity = capacity;
+    EvictIfNecessary();
+}
+
+void ResponseCache::Store(const std::string &URL, const BkHTTPHeaderMap &requestHeaders, const ResponseImpl &response)
+{
+    if (!IsStorable(response) || !IsSharable(requestHeaders, response))
+        return;
+
+    const base::TimeDelta lifetime = FreshnessLifetime(response);
+    if (lifetime.is_zero())
+        return;
+
+    Entry e;
+    e.URL = URL;
+    e.size = URL.length() + response.BodyLength();
+    for (const auto &it : response.Headers().GetRawMap())
+        e.size += it.first.length() + it.second.length();
+
+    if (!GetVaryValues(response, requestHeaders, e.vary))
+        return;
+
+    e.response = std::make_shared<ResponseImpl>(response);
+    e.expiry = base::TimeTicks::Now() + lifetime;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (e.size > m_capacity)
+        return;
+
+    auto it = m_index.find(URL);
+    if (std::end(m_index) != it)
+    {
+        m_bytes -= it->second->size;
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+
+    m_bytes += e.size;
+    m_entries.push_front(std::move(e));
+    m_index[URL] = m_entries.begin();
+    EvictIfNecessary();
+}
+
+} // namespace BlinKit
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace BlinKit;
+
+extern "C" {
+
+BKEXPORT void BKAPI BkGetResourceCacheStats(BkResourceCacheStats *stats)
+{
+    BkResourceCacheStats ret;
+    memset(&ret, 0, sizeof(BkResourceCacheStats));
+    ret.SizeOfStruct = sizeof(BkResourceCacheStats);
+    AppImpl::Get().GetResponseCache().GetStats(ret);
+
+    size_t size = sizeof(BkResourceCacheStats);
+    if (stats->SizeOfStruct < size)
+        size = stats->SizeOfStruct;
+    memcpy(stats, &ret, size);
+}
+
+BKEXPORT void BKAPI BkSetResourceCacheCapacity(size_t capacity)
+{
+    AppImpl::Get().GetResponseCache().SetCapacity(capacity);
+}
+
+} // extern "C"
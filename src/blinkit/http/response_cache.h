@@ -0,0 +1,85 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: response_cache.h
+// Description: ResponseCache Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINKIT_RESPONSE_CACHE_H
+#define BLINKIT_BLINKIT_RESPONSE_CACHE_H
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "base/time/time.h"
+
+class ResponseImpl;
+struct BkResourceCacheStats;
+
+namespace BlinKit {
+
+class BkHTTPHeaderMap;
+
+// Process-wide memory cache of subresource responses, shared by all crawlers.
+// Entries are keyed by URL, and only match the requests which carry the same
+// values for the headers listed in the Vary header of the response. A response
+// is cached as long as its Cache-Control max-age allows, the least recently
+// used ones are evicted once the capacity (in bytes) is exceeded. Responses
+// which may be personalised are not cached, see IsSharable.
+class ResponseCache
+{
+public:
+    static const size_t DefaultCapacity = 64 * 1024 * 1024;
+
+    ResponseCache(void) = default;
+
+    // Returns a copy of the cached response, which is free to be modified (hijacked) by the caller.
+    std::shared_ptr<ResponseImpl> Lookup(const std::string &URL, const BkHTTPHeaderMap &requestHeaders);
+    void Store(const std::string &URL, const BkHTTPHeaderMap &requestHeaders, const ResponseImpl &response);
+
+    void SetCapacity(size_t capacity);
+    void GetStats(BkResourceCacheStats &stats) const;
+
+    // Cache-Control rules, shared with the disk cache.
+    static bool IsStorable(const ResponseImpl &response);
+    // Whether the response may be reused for other crawls, which is not the case for private responses, nor for
+    // responses to requests with credentials, unless they are explicitly public.
+    static bool IsSharable(const BkHTTPHeaderMap &requestHeaders, const ResponseImpl &response);
+    // Zero if the response must be revalidated before being reused. s-maxage goes before max-age, as for any shared
+    // cache.
+    static base::TimeDelta FreshnessLifetime(const ResponseImpl &response);
+    // The request header values a reuse must match, false for "Vary: *", which matches no other request.
+    using VaryValues = std::vector<std::pair<std::string, std::string>>;
+    static bool GetVaryValues(const ResponseImpl &response, const BkHTTPHeaderMap &requestHeaders, VaryValues &dst);
+private:
+    void EvictIfNecessary(void);
+
+    struct Entry {
+        std::string URL;
+        VaryValues vary;
+        std::shared_ptr<const ResponseImpl> response;
+        base::TimeTicks expiry;
+        size_t size;
+    };
+    using EntryList = std::list<Entry>;
+
+    mutable std::mutex m_lock;
+    EntryList m_entries; // Most recently used first.
+    std::unordered_map<std::string, EntryList::iterator> m_index;
+    size_t m_capacity = DefaultCapacity;
+    size_t m_bytes = 0;
+    size_t m_hits = 0, m_misses = 0, m_evictions = 0;
+};
+
+} // namespace BlinKit
+
+#endif // BLINKIT_BLINKIT_RESPONSE_CACHE_H
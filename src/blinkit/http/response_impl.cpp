@@ -21,7 +21,7 @@ using namespace BlinKit;
 
 ResponseImpl::ResponseImpl(const std::string &URL) : m_originURL(URL), m_URL(URL)
 {
-    // Nothing
+    ClearTiming();
 }
 
 void ResponseImpl::AppendData(const void *data, size_t cb)
@@ -36,6 +36,32 @@ void ResponseImpl::AppendHeader(const char *name, const char *val)
     m_headers.Set(name, val);
 }
 
+const char* ResponseImpl::BorrowCookie(size_t index, size_t *length) const
+{
+    if (m_cookies.size() <= index)
+        return nullptr;
+
+    const std::string &cookie = m_cookies.at(index);
+    *length = cookie.length();
+    return cookie.data();
+}
+
+const char* ResponseImpl::BorrowHeader(const char *name, size_t *length) const
+{
+    const std::string *ret = m_headers.Find(name);
+    if (nullptr == ret)
+        return nullptr;
+
+    *length = ret->length();
+    return ret->data();
+}
+
+void ResponseImpl::ClearTiming(void)
+{
+    memset(&m_timing, 0, sizeof(BkResponseTiming));
+    m_timing.SizeOfStruct = sizeof(BkResponseTiming);
+}
+
 int ResponseImpl::GetCookie(size_t index, BkBuffer *dst) const
 {
     if (m_cookies.size() <= index)
@@ -71,14 +97,23 @@ int ResponseImpl::GetData(int data, BkBuffer *dst) const
 
 int ResponseImpl::GetHeader(const char *name, BkBuffer *dst) const
 {
-    std::string ret = m_headers.Get(name);
-    if (ret.empty())
+    size_t length;
+    const char *ret = BorrowHeader(name, &length);
+    if (nullptr == ret || 0 == length)
         return BK_ERR_NOT_FOUND;
 
-    BkSetBufferData(dst, ret.data(), ret.length());
+    BkSetBufferData(dst, ret, length);
     return BK_ERR_SUCCESS;
 }
 
+void ResponseImpl::GetTiming(BkResponseTiming *dst) const
+{
+    size_t size = sizeof(BkResponseTiming);
+    if (dst->SizeOfStruct < size)
+        size = dst->SizeOfStruct;
+    memcpy(dst, &m_timing, size);
+}
+
 void ResponseImpl::GZipInflate(void)
 {
     const size_t BufSize = 4096;
@@ -159,6 +194,17 @@ void ResponseImpl::ParseHeaders(const std::string &rawHeaders)
     }
 }
 
+void ResponseImpl::Release(void)
+{
+    // Declared ahead of the lock, so the response goes after the lock is released.
+    std::shared_ptr<ResponseImpl> self;
+
+    std::unique_lock<std::mutex> lock(m_retainer.lock);
+    ASSERT(m_retainer.count > 0);
+    if (0 == --m_retainer.count)
+        self.swap(m_retainer.self);
+}
+
 void ResponseImpl::ResetForRedirection(void)
 {
     m_errorCode = BK_ERR_SUCCESS;
@@ -182,10 +228,42 @@ std::string ResponseImpl::ResolveRedirection(void)
     return ret;
 }
 
+void ResponseImpl::Retain(void)
+{
+    std::unique_lock<std::mutex> lock(m_retainer.lock);
+    if (0 == m_retainer.count++)
+        m_retainer.self = shared_from_this();
+}
+
+void ResponseImpl::VisitHeaders(BkHeaderVisitor visitor, void *userData) const
+{
+    for (const auto &it : m_headers.GetRawMap())
+    {
+        if (!visitor(it.first.data(), it.first.length(), it.second.data(), it.second.length(), userData))
+            break;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 extern "C" {
 
+BKEXPORT const void* BKAPI BkBorrowResponseBody(BkResponse response, size_t *size)
+{
+    *size = response->BodyLength();
+    return response->BodyData();
+}
+
+BKEXPORT const char* BKAPI BkBorrowResponseCookie(BkResponse response, size_t index, size_t *length)
+{
+    return response->BorrowCookie(index, length);
+}
+
+BKEXPORT const char* BKAPI BkBorrowResponseHeader(BkResponse response, const char *name, size_t *length)
+{
+    return response->BorrowHeader(name, length);
+}
+
 BKEXPORT int BKAPI BkGetResponseCookie(BkResponse response, size_t index, BkBuffer *dst)
 {
     return response->GetCookie(index, dst);
@@ -211,4 +289,25 @@ BKEXPORT int BKAPI BkGetResponseStatusCode(BkResponse response)
     return response->StatusCode();
 }
 
+BKEXPORT void BKAPI BkGetResponseTiming(BkResponse response, BkResponseTiming *timing)
+{
+    response->GetTiming(timing);
+}
+
+BKEXPORT void BKAPI BkReleaseResponse(BkResponse response)
+{
+    response->Release();
+}
+
+BKEXPORT BkResponse BKAPI BkRetainResponse(BkResponse response)
+{
+    response->Retain();
+    return response;
+}
+
+BKEXPORT void BKAPI BkVisitResponseHeaders(BkResponse response, BkHeaderVisitor visitor, void *userData)
+{
+    response->VisitHeaders(visitor, userData);
+}
+
 } // extern "C"
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
 #include "bk_http.h"
 #include "blinkit/common/bk_http_header_map.h"
 
@@ -31,6 +32,12 @@ public:
     size_t CookiesCount(void) const { return m_cookies.size(); }
     int GetCookie(size_t index, BkBuffer *dst) const;
     void Hijack(const void *newBody, size_t length);
+    void GetTiming(BkResponseTiming *dst) const;
+    const char* BorrowCookie(size_t index, size_t *length) const;
+    const char* BorrowHeader(const char *name, size_t *length) const;
+    void VisitHeaders(BkHeaderVisitor visitor, void *userData) const;
+    void Retain(void);
+    void Release(void);
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     void ResetForRedirection(void);
@@ -44,10 +51,16 @@ public:
     const char* BodyData(void) const { return m_body.empty() ? nullptr : reinterpret_cast<const char *>(m_body.data()); }
     int BodyLength(void) const { return m_body.size(); }
 
+    const std::vector<std::string>& Cookies(void) const { return m_cookies; }
+
     const std::string& CurrentURL(void) const { return m_URL; }
     void SetCurrentURL(const std::string &URL) { m_URL = URL; }
 
     void SetStatusCode(int statusCode) { m_statusCode = statusCode; }
+
+    const BkResponseTiming& Timing(void) const { return m_timing; }
+    void SetTiming(const BkResponseTiming &timing) { m_timing = timing; }
+    void ClearTiming(void);
     void AppendHeader(const char *name, const char *val);
 
     void ParseHeaders(const std::string &rawHeaders);
@@ -61,6 +74,18 @@ private:
     BlinKit::BkHTTPHeaderMap m_headers;
     std::vector<std::string> m_cookies;
     std::vector<unsigned char> m_body;
+    BkResponseTiming m_timing;
+
+    // Keeps the response alive for BkRetainResponse, not copied along with it.
+    struct Retainer {
+        Retainer(void) = default;
+        Retainer(const Retainer &) {}
+        Retainer& operator=(const Retainer &) { return *this; }
+
+        std::mutex lock;
+        unsigned count = 0;
+        std::shared_ptr<ResponseImpl> self;
+    } m_retainer;
 };
 
 #endif // BLINKIT_BLINKIT_RESPONSE_IMPL_H
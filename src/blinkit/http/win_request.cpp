@@ -46,7 +46,6 @@ void WinRequest::Cancel(void)
 {
     assert(nullptr != m_hEventCancel);
     SetEvent(m_hEventCancel);
-    RequestImpl::Release();
 }
 
 int WinRequest::Continue(ThreadWorker nextWorker, bool signal)
@@ -54,6 +54,11 @@ ContextImpl::~ContextImpl(void)
     duk_destroy_heap(m_ctx);
 }
 
+void ContextImpl::CollectGarbage(void)
+{
+    duk_gc(m_ctx, 0);
+}
+
 bool ContextImpl::AccessCrawler(const Callback &worker)
 {
     const duk_idx_t top = duk_get_top(m_ctx);
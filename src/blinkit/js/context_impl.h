@@ -41,6 +41,7 @@ public:
     static ContextImpl* From(blink::ExecutionContext *executionContext);
 
     void Reset(void);
+    void CollectGarbage(void);
 
     const char* LookupPrototypeName(const std::string &tagName) const;
 
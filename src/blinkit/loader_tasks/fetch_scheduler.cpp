@@ -0,0 +1,126 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: fetch_scheduler.cpp
+// Description: FetchScheduler Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "fetch_scheduler.h"
+
+#include "bk_crawler.h"
+#include "blinkit/app/app_impl.h"
+#include "blinkit/loader_tasks/http_loader_task.h"
+
+namespace BlinKit {
+
+bool FetchScheduler::CanStart(const std::string &host) const
+{
+    if (0 != m_totalLimit && m_inFlight >= m_totalLimit)
+        return false;
+    if (0 == m_perHostLimit)
+        return true;
+
+    auto it = m_inFlightPerHost.find(host);
+    return std::end(m_inFlightPerHost) == it || it->second < m_perHostLimit;
+}
+
+void FetchScheduler::Finish(const std::string &host)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    ASSERT(m_inFlight > 0);
+    --m_inFlight;
+
+    auto it = m_inFlightPerHost.find(host);
+    ASSERT(std::end(m_inFlightPerHost) != it);
+    if (std::end(m_inFlightPerHost) != it && 0 == --it->second)
+        m_inFlightPerHost.erase(it);
+
+    StartPending(lock);
+}
+
+void FetchScheduler::Schedule(HTTPLoaderTask *task, const std::string &host, blink::ResourceLoadPriority priority)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    // Nothing queued can start at this moment, otherwise it would have been started, so a request which fits is
+    // never ahead of a more important one.
+    if (CanStart(host))
+    {
+        ++m_inFlight;
+        ++m_inFlightPerHost[host];
+        lock.unlock();
+        task->StartTransfer();
+        return;
+    }
+
+    Order order = { static_cast<int>(priority), m_sequence++ };
+    m_pending.emplace(order, Pending({ task, host }));
+}
+
+void FetchScheduler::SetLimits(unsigned total, unsigned perHost)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_totalLimit = total;
+    m_perHostLimit = perHost;
+    StartPending(lock);
+}
+
+void FetchScheduler::StartPending(std::unique_lock<std::mutex> &lock)
+{
+    std::vector<HTTPLoaderTask *> tasks;
+    for (auto it = m_pending.begin(); m_pending.end() != it;)
+    {
+        if (0 != m_totalLimit && m_inFlight >= m_totalLimit)
+            break;
+
+        const std::string &host = it->second.host;
+        if (!CanStart(host))
+        {
+            ++it;
+            continue;
+        }
+
+        ++m_inFlight;
+        ++m_inFlightPerHost[host];
+        tasks.push_back(it->second.task);
+        it = m_pending.erase(it);
+    }
+
+    lock.unlock();
+    for (HTTPLoaderTask *task : tasks)
+        task->StartTransfer();
+}
+
+bool FetchScheduler::Withdraw(HTTPLoaderTask *task)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    for (auto it = m_pending.begin(); m_pending.end() != it; ++it)
+    {
+        if (task == it->second.task)
+        {
+            m_pending.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace BlinKit
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace BlinKit;
+
+extern "C" {
+
+BKEXPORT void BKAPI BkSetFetchLimits(unsigned total, unsigned perHost)
+{
+    AppImpl::Get().GetFetchScheduler().SetLimits(total, perHost);
+}
+
+} // extern "C"
@@ -0,0 +1,75 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: fetch_scheduler.h
+// Description: FetchScheduler Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINKIT_FETCH_SCHEDULER_H
+#define BLINKIT_BLINKIT_FETCH_SCHEDULER_H
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "third_party/blink/renderer/platform/loader/fetch/resource_load_priority.h"
+
+namespace BlinKit {
+
+class HTTPLoaderTask;
+
+// Sits between the loader tasks and the transport, and caps the transfers in
+// flight, both in total and per host. Requests over the caps are queued, and
+// started by priority (then in order of arrival) when a transfer finishes, so
+// documents and parser blocking scripts go ahead of late discovered resources.
+class FetchScheduler
+{
+public:
+    static const unsigned DefaultTotalLimit = 32;
+    static const unsigned DefaultPerHostLimit = 6;
+
+    // Starts the transfer of |task| right now if the caps allow, or queues it.
+    void Schedule(HTTPLoaderTask *task, const std::string &host, blink::ResourceLoadPriority priority);
+    // Releases the slot of a finished transfer, and starts the queued ones which fit now.
+    void Finish(const std::string &host);
+    // Takes |task| out of the queue, returns false if it is not there (started already).
+    bool Withdraw(HTTPLoaderTask *task);
+
+    // 0 for no limit.
+    void SetLimits(unsigned total, unsigned perHost);
+private:
+    bool CanStart(const std::string &host) const;
+    void StartPending(std::unique_lock<std::mutex> &lock);
+
+    struct Order {
+        int priority;
+        uint64_t sequence;
+        bool operator<(const Order &o) const
+        {
+            if (priority != o.priority)
+                return priority > o.priority;
+            return sequence < o.sequence;
+        }
+    };
+    struct Pending {
+        HTTPLoaderTask *task;
+        std::string host;
+    };
+
+    std::mutex m_lock;
+    unsigned m_totalLimit = DefaultTotalLimit, m_perHostLimit = DefaultPerHostLimit;
+    unsigned m_inFlight = 0;
+    std::unordered_map<std::string, unsigned> m_inFlightPerHost;
+    std::map<Order, Pending> m_pending;
+    uint64_t m_sequence = 0;
+};
+
+} // namespace BlinKit
+
+#endif // BLINKIT_BLINKIT_FETCH_SCHEDULER_H
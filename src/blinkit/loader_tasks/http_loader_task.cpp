@@ -11,13 +11,20 @@
 
 #include "http_loader_task.h"
 
+#include <thread>
 #include "base/auto_reset.h"
 #include "base/single_thread_task_runner.h"
+#include "blinkit/app/app_impl.h"
+#include "blinkit/blink_impl/cookie_jar_impl.h"
 #include "blinkit/crawler/crawler_impl.h"
+#include "blinkit/http/response_cache.h"
 #include "blinkit/http/request_impl.h"
 #include "blinkit/http/response_impl.h"
+#include "blinkit/loader_tasks/fetch_scheduler.h"
+#include "blinkit/loader_tasks/request_coalescer.h"
 #include "net/http/http_util.h"
 #include "third_party/blink/public/platform/web_url_loader_client.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_error.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_response.h"
 #include "third_party/blink/renderer/platform/network/http_names.h"
 #include "third_party/blink/renderer/platform/wtf/wtf.h"
@@ -26,13 +33,55 @@ using namespace blink;
 
 namespace BlinKit {
 
-HTTPLoaderTask::HTTPLoaderTask(BkCrawler crawler, const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, WebURLLoaderClient *client)
+HTTPLoaderTask::HTTPLoaderTask(BkCrawler crawler, const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, const ClientRef &client)
     : LoaderTask(taskRunner, client)
     , m_crawler(crawler)
 {
 }
 
-HTTPLoaderTask::~HTTPLoaderTask(void) = default;
+HTTPLoaderTask::~HTTPLoaderTask(void)
+{
+    if (m_waiting && !m_coalescingKey.empty())
+        AppImpl::Get().GetRequestCoalescer().Leave(m_coalescingKey, this);
+}
+
+bool HTTPLoaderTask::Abort(void)
+{
+    std::unique_lock<std::mutex> lock(m_transferLock);
+
+    if (!m_coalescingKey.empty())
+    {
+        RequestCoalescer &coalescer = AppImpl::Get().GetRequestCoalescer();
+        if (m_waiting)
+        {
+            // Unless the request waited for is reporting to this one already.
+            if (!coalescer.Leave(m_coalescingKey, this))
+                return false;
+            m_coalescingKey.clear();
+            m_aborted = true;
+            return true;
+        }
+
+        // Requests of other crawlers are waiting for this one, let it go on.
+        if (!coalescer.Abandon(m_coalescingKey))
+            return false;
+        m_coalescingKey.clear();
+    }
+
+    m_aborted = true;
+    if (nullptr != m_controller)
+    {
+        m_controller->CancelWork();
+        m_controller = nullptr;
+        return false;
+    }
+
+    // Otherwise, StartTransfer is on the way, and it will see the flag.
+    if (!AppImpl::Get().GetFetchScheduler().Withdraw(this))
+        return false;
+    m_scheduled = false;
+    return true;
+}
 
 int HTTPLoaderTask::CancelWork(void)
 {
@@ -43,6 +92,24 @@ int HTTPLoaderTask::CancelWork(void)
     return BK_ERR_SUCCESS;
 }
 
+void HTTPLoaderTask::CoalescedRequestComplete(const std::shared_ptr<ResponseImpl> &response)
+{
+    // Out of the coalescer already, and out of reach of Abort once detached.
+    DetachTransfer();
+    m_coalescingKey.clear();
+
+    m_response = response;
+    PostRequestComplete();
+}
+
+void HTTPLoaderTask::CoalescedRequestFailed(int errorCode)
+{
+    DetachTransfer();
+    m_coalescingKey.clear();
+
+    RequestFailed(errorCode);
+}
+
 int HTTPLoaderTask::ContinueWorking(void)
 {
     if (m_callingCrawler)
@@ -52,24 +119,91 @@ int HTTPLoaderTask::ContinueWorking(void)
     return BK_ERR_SUCCESS;
 }
 
+void HTTPLoaderTask::DetachTransfer(void)
+{
+    if (!m_transfers)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_transfers->lock);
+    m_transfers->tasks.erase(this);
+}
+
+void HTTPLoaderTask::DiskCacheLoaded(const std::shared_ptr<DiskCache::Entry> &entry)
+{
+    bool aborted;
+    {
+        std::unique_lock<std::mutex> lock(m_transferLock);
+        aborted = m_aborted;
+    }
+    if (aborted || nullptr == m_crawler)
+    {
+        // Truncated while reading, or the crawler is gone.
+        RequestFailed(BK_ERR_CANCELLED);
+        return;
+    }
+
+    if (entry && entry->IsFresh())
+    {
+        DetachTransfer();
+        m_response = entry->TakeResponse();
+        if (m_cacheable)
+            AppImpl::Get().GetResponseCache().Store(m_url.AsString(), m_requestHeaders, *m_response);
+        m_cacheable = false;
+        ProcessRequestComplete();
+        return;
+    }
+
+    // Stale, ask the server whether it is still valid.
+    if (entry && entry->AddValidators(m_requestHeaders))
+        m_diskEntry = entry;
+    m_storeToDisk = true;
+    StartFetch();
+}
+
 void HTTPLoaderTask::DoCancel(void)
 {
     ASSERT(IsMainThread());
-    ASSERT(false); // BKTODO:
+    if (WebURLLoaderClient *client = *m_client)
+        client->DidFail(ResourceError(BK_ERR_CANCELLED, m_url));
+    delete this;
 }
 
 void HTTPLoaderTask::DoContinue(void)
 {
     ASSERT(IsMainThread());
 
+    WebURLLoaderClient *client = *m_client;
+    if (nullptr == client || nullptr == m_crawler)
+    {
+        // Cancelled by blink, or the crawler is gone.
+        delete this;
+        return;
+    }
+
+    m_crawler->CountReceivedBytes(m_response->BodyLength());
+    if (m_transferred)
+        m_crawler->CountTransfer(m_response->Timing());
+
     ResourceResponse response(BkURL(m_response->CurrentURL()));
     PopulateResourceResponse(response);
-    m_client->DidReceiveResponse(response);
-    m_client->DidReceiveData(m_response->BodyData(), m_response->BodyLength());
-    m_client->DidFinishLoading();
+    client->DidReceiveResponse(response);
+    client->DidReceiveData(m_response->BodyData(), m_response->BodyLength());
+    client->DidFinishLoading();
     delete this;
 }
 
+void HTTPLoaderTask::FailOverByteLimit(void)
+{
+    ASSERT(IsMainThread());
+
+    DetachTransfer();
+    // The transfer was stopped as soon as it went over what the crawl had left, which truncates the crawl.
+    if (nullptr != m_crawler)
+        m_crawler->CountReceivedBytes(static_cast<size_t>(*m_byteLimit) + 1);
+    LoaderTask::ReportError(m_client, m_taskRunner.get(), BK_ERR_CANCELLED, m_url);
+    delete this;
+}
+
 AtomicString HTTPLoaderTask::GetResponseHeader(const AtomicString &name) const
 {
     std::string ret = m_response->Headers().Get(name.StdUtf8());
@@ -127,6 +261,9 @@ bool HTTPLoaderTask::ProcessHijackResponse(void)
 {
     if (HijackType::kMainHTML == m_hijackType)
         return false;
+    // The response may be shared by coalesced requests, hijack a private copy.
+    if (m_crawler->CanHijackResponse() && m_response.use_count() > 1)
+        m_response = std::make_shared<ResponseImpl>(*m_response);
     m_crawler->HijackResponse(m_response.get());
     return true;
 }
@@ -134,6 +271,13 @@ bool HTTPLoaderTask::ProcessHijackResponse(void)
 void HTTPLoaderTask::ProcessRequestComplete(void)
 {
     ASSERT(m_response);
+    if (nullptr == *m_client || nullptr == m_crawler)
+    {
+        // Cancelled by blink, or the crawler is gone, nobody cares about the response any more.
+        delete this;
+        return;
+    }
+
     do {
         if (ProcessHijackResponse())
             break;
@@ -154,17 +298,90 @@ void HTTPLoaderTask::ProcessRequestComplete(void)
     DoContinue();
 }
 
+void HTTPLoaderTask::PostRequestComplete(void)
+{
+    std::function<void()> callback = std::bind(&HTTPLoaderTask::ProcessRequestComplete, this);
+    m_taskRunner->PostTask(FROM_HERE, callback);
+}
+
+void HTTPLoaderTask::ReleaseController(void)
+{
+    std::unique_lock<std::mutex> lock(m_transferLock);
+    if (nullptr != m_controller)
+    {
+        m_controller->Release();
+        m_controller = nullptr;
+    }
+}
+
+void HTTPLoaderTask::ReleaseTransferSlot(void)
+{
+    if (!m_scheduled)
+        return;
+    m_scheduled = false;
+    AppImpl::Get().GetFetchScheduler().Finish(m_host);
+}
+
 void HTTPLoaderTask::RequestComplete(BkResponse response)
 {
+    DetachTransfer();
+    ReleaseController();
+
     m_response = response->shared_from_this();
+    m_transferred = true;
+
+    const std::vector<std::string> &cookies = m_response->Cookies();
+    if (!cookies.empty())
+    {
+        CookieJarImpl &cookieJar = AppImpl::Get().CookieJar();
+        for (const std::string &cookie : cookies)
+            cookieJar.AddCookieEntry(m_response->CurrentURL(), cookie);
+    }
 
-    std::function<void()> callback = std::bind(&HTTPLoaderTask::ProcessRequestComplete, this);
-    m_taskRunner->PostTask(FROM_HERE, callback);
+    // Cached before being handed to the crawler, so a hijacked body never gets into the cache.
+    const std::string URL = m_url.AsString();
+    if (m_diskEntry && 304 == m_response->StatusCode())
+        m_response = AppImpl::Get().GetDiskCache()->Revalidate(URL, m_requestHeaders, *m_diskEntry, *m_response);
+    else if (m_storeToDisk)
+        AppImpl::Get().GetDiskCache()->Store(URL, m_requestHeaders, *m_response);
+    m_diskEntry.reset();
+
+    if (m_cacheable)
+        AppImpl::Get().GetResponseCache().Store(URL, m_requestHeaders, *m_response);
+
+    if (!m_coalescingKey.empty())
+        AppImpl::Get().GetRequestCoalescer().Complete(m_coalescingKey, m_response);
+
+    ReleaseTransferSlot();
+    PostRequestComplete();
 }
 
 void HTTPLoaderTask::RequestFailed(int errorCode)
 {
     BKLOG("HTTPLoaderTask::RequestFailed: %d.", errorCode);
+    const bool overByteLimit = BK_ERR_RANGE == errorCode;
+    if (!overByteLimit)
+        DetachTransfer();
+    ReleaseController();
+
+    if (!m_coalescingKey.empty())
+    {
+        // The byte limit is of this crawl, others waiting for the request just lose it.
+        AppImpl::Get().GetRequestCoalescer().Fail(m_coalescingKey, overByteLimit ? BK_ERR_CANCELLED : errorCode);
+    }
+    ReleaseTransferSlot();
+
+    if (overByteLimit)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_transferLock);
+            m_coalescingKey.clear();
+        }
+        // Still attached, so m_crawler gets reset if the crawler goes away before the callback.
+        std::function<void()> callback = std::bind(&HTTPLoaderTask::FailOverByteLimit, this);
+        m_taskRunner->PostTask(FROM_HERE, callback);
+        return;
+    }
     LoaderTask::ReportError(m_client, m_taskRunner.get(), errorCode, m_url);
     delete this;
 }
@@ -182,24 +399,105 @@ int HTTPLoaderTask::Run(const ResourceRequest &request)
         return BK_ERR_SUCCESS;
     }
 
-    BkRequest req = BkCreateRequest(URL.c_str(), *this);
-    if (nullptr == req)
+    BkHTTPHeaderMap headers = request.AllHeaders();
+    std::string cookies = AppImpl::Get().CookieJar().GetCookies(URL);
+    if (!cookies.empty())
+        headers.Set("Cookie", cookies);
+
+    const bool isGet = http_names::kGET == request.HttpMethod();
+    m_cacheable = isGet && HijackType::kMainHTML != m_hijackType;
+    if (m_cacheable)
+    {
+        m_response = AppImpl::Get().GetResponseCache().Lookup(URL, headers);
+        if (m_response)
+        {
+            m_cacheable = false;
+            PostRequestComplete();
+            return BK_ERR_SUCCESS;
+        }
+    }
+
+    m_method = request.HttpMethod().StdUtf8();
+    m_requestHeaders = headers;
+    m_host = m_url.Host();
+
+    // Documents go ahead of everything else.
+    m_priority = request.Priority();
+    if (HijackType::kMainHTML == m_hijackType)
+        m_priority = ResourceLoadPriority::kHighest;
+
+    // Attached before reading the disk cache, so a truncated crawl does not wait for the files.
+    m_transfers = m_crawler->AttachTransfer(this);
+
+    DiskCache *diskCache = isGet ? AppImpl::Get().GetDiskCache() : nullptr;
+    if (nullptr == diskCache)
+    {
+        StartFetch();
+        return BK_ERR_SUCCESS;
+    }
+
+    // The files are read by a worker thread, not to block the crawler thread, and nothing else touches the request
+    // headers until DiskCacheLoaded.
+    std::thread([this, diskCache, URL] {
+        std::shared_ptr<DiskCache::Entry> entry = diskCache->Load(URL, m_requestHeaders);
+        std::function<void()> callback = std::bind(&HTTPLoaderTask::DiskCacheLoaded, this, entry);
+        m_taskRunner->PostTask(FROM_HERE, callback);
+    }).detach();
+    return BK_ERR_SUCCESS;
+}
+
+void HTTPLoaderTask::StartFetch(void)
+{
+    if (m_cacheable)
     {
-        ASSERT(nullptr != req);
-        return BK_ERR_UNKNOWN;
+        // Set up before joining, as the in-flight request may report to this task, and even fail and delete it, at
+        // any moment after that. The response goes into caches by the in-flight request.
+        m_coalescingKey = RequestCoalescer::MakeKey(http_names::kGET.StdUtf8(), m_url.AsString(),
+            m_requestHeaders.Get("Cookie"));
+        m_waiting = true;
+        if (AppImpl::Get().GetRequestCoalescer().Join(m_coalescingKey, this))
+            return;
+        m_waiting = false;
     }
 
-    req->SetMethod(request.HttpMethod().StdUtf8());
-    req->SetHeaders(request.AllHeaders());
-    BKLOG("// BKTODO: Add body.");
+    m_byteLimit = m_crawler->RemainingBytes();
+    m_scheduled = true;
+    AppImpl::Get().GetFetchScheduler().Schedule(this, m_host, m_priority);
+}
+
+void HTTPLoaderTask::StartTransfer(void)
+{
+    const std::string URL = m_url.AsString();
 
-    int r = req->Perform();
-    if (BK_ERR_SUCCESS != r)
+    int r = BK_ERR_CANCELLED;
+    std::unique_lock<std::mutex> lock(m_transferLock);
+    if (!m_aborted)
     {
-        ASSERT(BK_ERR_SUCCESS == r);
-        delete req;
+        r = BK_ERR_UNKNOWN;
+        BkRequest req = BkCreateRequest(URL.c_str(), *this);
+        if (nullptr != req)
+        {
+            req->SetMethod(m_method);
+            req->SetHeaders(m_requestHeaders);
+            if (m_byteLimit.has_value())
+                req->SetByteLimit(*m_byteLimit);
+            BKLOG("// BKTODO: Add body.");
+
+            // Taken before performing, as the request may be over and gone at any moment after that. If performing
+            // fails, the request goes with the controller.
+            m_controller = req->GetController();
+            lock.unlock();
+
+            r = req->Perform();
+            if (BK_ERR_SUCCESS == r)
+                return;
+        }
     }
-    return r;
+    if (lock.owns_lock())
+        lock.unlock();
+
+    ASSERT(BK_ERR_SUCCESS == r || BK_ERR_CANCELLED == r);
+    RequestFailed(r);
 }
 
 } // namespace BlinKit
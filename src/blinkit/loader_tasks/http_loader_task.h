@@ -14,10 +14,13 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
+#include <unordered_set>
 #include "bk_crawler.h"
 #include "bk_http.h"
 #include "blinkit/common/bk_url.h"
+#include "blinkit/http/disk_cache.h"
 #include "blinkit/loader_tasks/loader_task.h"
 #include "blinkit/misc/controller_impl.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_request.h"
@@ -29,21 +32,52 @@ class ResourceResponse;
 
 namespace BlinKit {
 
+class HTTPLoaderTask;
+
+// The transfers of a crawler, tracked to be aborted if the crawl gets truncated. Shared by the crawler and its tasks,
+// which detach themselves from any thread, even after the crawler is gone.
+struct TransferSet
+{
+    std::mutex lock;
+    std::unordered_set<HTTPLoaderTask *> tasks;
+};
+
 class HTTPLoaderTask final : public LoaderTask, public BkRequestClientImpl, public ControllerImpl
 {
 public:
-    HTTPLoaderTask(BkCrawler crawler, const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, blink::WebURLLoaderClient *client);
+    HTTPLoaderTask(BkCrawler crawler, const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, const ClientRef &client);
     ~HTTPLoaderTask(void) override;
+
+    // Called by RequestCoalescer, from the network thread. The task is attached to its crawler while waiting, just like
+    // a transfer of its own.
+    void CoalescedRequestComplete(const std::shared_ptr<ResponseImpl> &response);
+    void CoalescedRequestFailed(int errorCode);
+    // Called by FetchScheduler, once a transfer slot is available.
+    void StartTransfer(void);
+    // Called by CrawlerImpl when the crawl is truncated. Returns true if the task was still queued or waiting for a
+    // coalesced request, then it has to be failed by FailAborted.
+    bool Abort(void);
+    void FailAborted(void) { RequestFailed(BK_ERR_CANCELLED); }
+    // Called by CrawlerImpl when it goes away, with the transfer set locked.
+    void DetachCrawler(void) { m_crawler = nullptr; }
 private:
     AtomicString GetResponseHeader(const AtomicString &name) const;
 
     bool ProcessHijackRequest(const std::string &URL);
     bool ProcessHijackResponse(void);
     void ProcessRequestComplete(void);
+    void PostRequestComplete(void);
+    void ReleaseTransferSlot(void);
+    void DetachTransfer(void);
+    void ReleaseController(void);
     void PopulateHijackedResponse(const std::string &URL, const std::string &hijack);
     void PopulateResourceResponse(blink::ResourceResponse &response) const;
     void DoContinue(void);
     void DoCancel(void);
+    void FailOverByteLimit(void);
+    // Called on the crawler thread, once the disk cache is read by a worker thread.
+    void DiskCacheLoaded(const std::shared_ptr<DiskCache::Entry> &entry);
+    void StartFetch(void);
 
     // LoaderTask
     int Run(const blink::ResourceRequest &request) override;
@@ -55,10 +89,26 @@ private:
     int ContinueWorking(void) override;
     int CancelWork(void) override;
 
-    BkCrawler m_crawler;
+    BkCrawler m_crawler; // Only used on the crawler thread.
+    std::shared_ptr<TransferSet> m_transfers;
     BkURL m_url;
     blink::HijackType m_hijackType = blink::HijackType::kOther;
     std::shared_ptr<ResponseImpl> m_response;
+    bool m_cacheable = false;
+    std::string m_method, m_host;
+    BkHTTPHeaderMap m_requestHeaders;
+    blink::ResourceLoadPriority m_priority = blink::ResourceLoadPriority::kUnresolved;
+    std::optional<uint64_t> m_byteLimit; // What the crawl has left, when the task got scheduled.
+    bool m_scheduled = false;
+    bool m_storeToDisk = false;
+    std::shared_ptr<DiskCache::Entry> m_diskEntry; // Being revalidated.
+    std::string m_coalescingKey; // Other crawlers may be waiting for this request, or this one for another's.
+    bool m_waiting = false;
+
+    std::mutex m_transferLock;
+    ControllerImpl *m_controller = nullptr; // Of the transfer in flight.
+    bool m_aborted = false;
+    bool m_transferred = false; // The response came by a transfer of its own.
 
     bool m_callingCrawler = false;
     std::optional<bool> m_cancel;
@@ -20,20 +20,21 @@ using namespace blink;
 
 namespace BlinKit {
 
-LoaderTask::LoaderTask(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, WebURLLoaderClient *client)
+LoaderTask::LoaderTask(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, const ClientRef &client)
     : m_taskRunner(taskRunner), m_client(client)
 {
 }
 
 LoaderTask::~LoaderTask(void) = default;
 
-static void ErrorWorker(WebURLLoaderClient *client, const ResourceError error)
+static void ErrorWorker(const LoaderTask::ClientRef &client, const ResourceError error)
 {
     ASSERT(IsMainThread());
-    client->DidFail(error);
+    if (WebURLLoaderClient *c = *client)
+        c->DidFail(error);
 }
 
-void LoaderTask::ReportError(WebURLLoaderClient *client, base::SingleThreadTaskRunner *taskRunner, int errorCode, const BkURL &URL)
+void LoaderTask::ReportError(const ClientRef &client, base::SingleThreadTaskRunner *taskRunner, int errorCode, const BkURL &URL)
 {
     ResourceError error(errorCode, URL);
     std::function<void()> callback = std::bind(&ErrorWorker, client, error);
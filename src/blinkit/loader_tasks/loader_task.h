@@ -31,14 +31,18 @@ class LoaderTask
 public:
     virtual ~LoaderTask(void);
 
-    static void ReportError(blink::WebURLLoaderClient *client, base::SingleThreadTaskRunner *taskRunner, int errorCode, const BkURL &URL);
+    // Shared with the WebURLLoader, which clears it when it goes, e.g. cancelled by blink. Used on the engine thread
+    // only.
+    typedef std::shared_ptr<blink::WebURLLoaderClient *> ClientRef;
+
+    static void ReportError(const ClientRef &client, base::SingleThreadTaskRunner *taskRunner, int errorCode, const BkURL &URL);
 
     virtual int Run(const blink::ResourceRequest &request) = 0;
 protected:
-    LoaderTask(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, blink::WebURLLoaderClient *client);
+    LoaderTask(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner, const ClientRef &client);
 
     std::shared_ptr<base::SingleThreadTaskRunner> m_taskRunner;
-    blink::WebURLLoaderClient *m_client;
+    const ClientRef m_client;
 };
 
 } // namespace BlinKit
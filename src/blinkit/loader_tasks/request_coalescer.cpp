@@ -0,0 +1,133 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: request_coalescer.cpp
+// Description: RequestCoalescer Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "request_coalescer.h"
+
+#include <algorithm>
+#include "bk_crawler.h"
+#include "blinkit/app/app_impl.h"
+#include "blinkit/loader_tasks/http_loader_task.h"
+
+namespace BlinKit {
+
+bool RequestCoalescer::Abandon(const std::string &key)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    auto it = m_inFlight.find(key);
+    if (std::end(m_inFlight) == it)
+        return true;
+    if (!it->second.empty())
+        return false;
+
+    m_inFlight.erase(it);
+    return true;
+}
+
+void RequestCoalescer::Complete(const std::string &key, const std::shared_ptr<ResponseImpl> &response)
+{
+    for (HTTPLoaderTask *waiter : TakeWaiters(key))
+        waiter->CoalescedRequestComplete(response);
+}
+
+void RequestCoalescer::Fail(const std::string &key, int errorCode)
+{
+    for (HTTPLoaderTask *waiter : TakeWaiters(key))
+        waiter->CoalescedRequestFailed(errorCode);
+}
+
+void RequestCoalescer::GetStats(BkCoalescingStats &stats) const
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    stats.Transfers = m_transfers;
+    stats.Coalesced = m_coalesced;
+}
+
+bool RequestCoalescer::Join(const std::string &key, HTTPLoaderTask *waiter)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    auto it = m_inFlight.find(key);
+    if (std::end(m_inFlight) == it)
+    {
+        m_inFlight.emplace(key, std::vector<HTTPLoaderTask *>());
+        ++m_transfers;
+        return false;
+    }
+
+    it->second.push_back(waiter);
+    ++m_coalesced;
+    return true;
+}
+
+bool RequestCoalescer::Leave(const std::string &key, HTTPLoaderTask *waiter)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    auto it = m_inFlight.find(key);
+    if (std::end(m_inFlight) == it)
+        return false;
+
+    std::vector<HTTPLoaderTask *> &waiters = it->second;
+    auto w = std::find(waiters.begin(), waiters.end(), waiter);
+    if (waiters.end() == w)
+        return false;
+
+    waiters.erase(w);
+    return true;
+}
+
+std::string RequestCoalescer::MakeKey(const std::string &method, const std::string &URL, const std::string &cookies)
+{
+    std::string ret(method);
+    ret.push_back(' ');
+    ret.append(URL);
+    ret.push_back('\n');
+    ret.append(cookies);
+    return ret;
+}
+
+std::vector<HTTPLoaderTask *> RequestCoalescer::TakeWaiters(const std::string &key)
+{
+    std::vector<HTTPLoaderTask *> ret;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    auto it = m_inFlight.find(key);
+    if (std::end(m_inFlight) != it)
+    {
+        ret.swap(it->second);
+        m_inFlight.erase(it);
+    }
+    return ret;
+}
+
+} // namespace BlinKit
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace BlinKit;
+
+extern "C" {
+
+BKEXPORT void BKAPI BkGetCoalescingStats(BkCoalescingStats *stats)
+{
+    BkCoalescingStats ret;
+    memset(&ret, 0, sizeof(BkCoalescingStats));
+    ret.SizeOfStruct = sizeof(BkCoalescingStats);
+    AppImpl::Get().GetRequestCoalescer().GetStats(ret);
+
+    size_t size = sizeof(BkCoalescingStats);
+    if (stats->SizeOfStruct < size)
+        size = stats->SizeOfStruct;
+    memcpy(stats, &ret, size);
+}
+
+} // extern "C"
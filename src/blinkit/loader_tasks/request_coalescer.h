@@ -0,0 +1,61 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: request_coalescer.h
+// Description: RequestCoalescer Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINKIT_REQUEST_COALESCER_H
+#define BLINKIT_BLINKIT_REQUEST_COALESCER_H
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ResponseImpl;
+struct BkCoalescingStats;
+
+namespace BlinKit {
+
+class HTTPLoaderTask;
+
+// Identical requests issued by several crawlers at the same time share one
+// transfer: the first one goes to the network, the others wait for it and
+// receive the same response object.
+class RequestCoalescer
+{
+public:
+    static std::string MakeKey(const std::string &method, const std::string &URL, const std::string &cookies);
+
+    // Returns false if there is no such request in flight, the caller is
+    // supposed to perform it and report with Complete or Fail then.
+    bool Join(const std::string &key, HTTPLoaderTask *waiter);
+    // Withdraws a waiter which is aborted or destroyed. Returns false if it
+    // is too late, the waiter is being reported to then.
+    bool Leave(const std::string &key, HTTPLoaderTask *waiter);
+    void Complete(const std::string &key, const std::shared_ptr<ResponseImpl> &response);
+    void Fail(const std::string &key, int errorCode);
+    // Called instead of Complete or Fail when the performer gives up. Returns
+    // false if there are waiters, then the request has to go on for them.
+    bool Abandon(const std::string &key);
+
+    void GetStats(BkCoalescingStats &stats) const;
+private:
+    std::vector<HTTPLoaderTask *> TakeWaiters(const std::string &key);
+
+    mutable std::mutex m_lock;
+    std::unordered_map<std::string, std::vector<HTTPLoaderTask *>> m_inFlight;
+    size_t m_transfers = 0, m_coalesced = 0;
+};
+
+} // namespace BlinKit
+
+#endif // BLINKIT_BLINKIT_REQUEST_COALESCER_H
@@ -0,0 +1,236 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: prefork_supervisor.cpp
+// Description: PreforkSupervisor Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "prefork_supervisor.h"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "blinkit/app/posix_app.h"
+
+namespace BlinKit {
+
+// Held while the supervisor is used through the exports, so it cannot go away meanwhile. Taken before its own lock.
+static std::mutex g_supervisorLock;
+static PreforkSupervisor *g_supervisor = nullptr;
+
+PreforkSupervisor::PreforkSupervisor(const BkPreforkClient &client)
+{
+    memset(&m_client, 0, sizeof(BkPreforkClient));
+    size_t size = sizeof(BkPreforkClient);
+    if (client.SizeOfStruct < size)
+        size = client.SizeOfStruct;
+    memcpy(&m_client, &client, size);
+
+    unsigned count = m_client.Workers;
+    if (0 == count)
+    {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        count = n > 0 ? n : 1;
+    }
+    m_workers.resize(count);
+}
+
+void PreforkSupervisor::FillStats(unsigned index, BkWorkerStats &stats) const
+{
+    BkWorkerStats ret;
+    memset(&ret, 0, sizeof(BkWorkerStats));
+    ret.SizeOfStruct = sizeof(BkWorkerStats);
+    ret.Index = index;
+    ret.Pid = m_workers[index].pid;
+    ret.Restarts = m_workers[index].restarts;
+    ret.LastStatus = m_workers[index].lastStatus;
+
+    size_t size = sizeof(BkWorkerStats);
+    if (stats.SizeOfStruct < size)
+        size = stats.SizeOfStruct;
+    memcpy(&stats, &ret, size);
+}
+
+unsigned PreforkSupervisor::GetStats(BkWorkerStats *stats, unsigned count) const
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (count > m_workers.size())
+        count = m_workers.size();
+    for (unsigned i = 0; i < count; ++i)
+        FillStats(i, stats[i]);
+    return count;
+}
+
+int PreforkSupervisor::Run(void)
+{
+    int ret = BK_ERR_SUCCESS;
+    for (unsigned i = 0; i < m_workers.size(); ++i)
+    {
+        if (!Spawn(i))
+        {
+            ret = BK_ERR_UNKNOWN;
+            Stop();
+            break;
+        }
+    }
+
+    for (;;)
+    {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            if (EINTR == errno)
+                continue;
+            break; // No more children.
+        }
+
+        unsigned index;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            for (index = 0; index < m_workers.size(); ++index)
+            {
+                if (m_workers[index].pid == pid)
+                    break;
+            }
+            if (index == m_workers.size())
+                continue; // Not a worker of ours.
+
+            m_workers[index].pid = 0;
+            m_workers[index].lastStatus = status;
+        }
+
+        if (nullptr != m_client.WorkerExited)
+        {
+            BkWorkerStats stats;
+            stats.SizeOfStruct = sizeof(BkWorkerStats);
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                FillStats(index, stats);
+            }
+            m_client.WorkerExited(&stats, m_client.UserData);
+        }
+
+        if (ShouldRestart(index, status))
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                ++m_workers[index].restarts;
+            }
+            Spawn(index);
+        }
+    }
+    return ret;
+}
+
+bool PreforkSupervisor::ShouldRestart(unsigned index, int status) const
+{
+    if (m_stopping || !WIFSIGNALED(status))
+        return false;
+    if (0 == m_client.MaxRestarts)
+        return true;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    return m_workers[index].restarts < m_client.MaxRestarts;
+}
+
+bool PreforkSupervisor::Spawn(unsigned index)
+{
+    // Held across the fork, so the worker never inherits it locked by a thread which does not exist there.
+    std::unique_lock<std::mutex> supervisorLock(g_supervisorLock);
+
+    PosixApp &app = PosixApp::Get();
+    app.PrepareForFork();
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        app.ResumeAfterFork(false);
+        BKLOG("Failed to fork worker %u.", index);
+        return false;
+    }
+
+    if (0 == pid)
+    {
+        app.ResumeAfterFork(true);
+        g_supervisor = nullptr;
+        supervisorLock.unlock();
+
+        // The worker is expected to finish with BkRunApp or BkFinalize, as a process of its own.
+        _exit(m_client.WorkerMain(index, m_client.UserData));
+    }
+
+    app.ResumeAfterFork(false);
+    supervisorLock.unlock();
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_workers[index].pid = pid;
+    return true;
+}
+
+void PreforkSupervisor::Stop(void)
+{
+    m_stopping = true;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    for (const Worker &worker : m_workers)
+    {
+        if (0 != worker.pid)
+            kill(worker.pid, SIGTERM);
+    }
+}
+
+} // namespace BlinKit
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace BlinKit;
+
+extern "C" {
+
+BKEXPORT unsigned BKAPI BkGetWorkerStats(struct BkWorkerStats *stats, unsigned count)
+{
+    std::unique_lock<std::mutex> lock(g_supervisorLock);
+    if (nullptr == g_supervisor)
+        return 0;
+    return g_supervisor->GetStats(stats, count);
+}
+
+BKEXPORT int BKAPI BkRunPreforkWorkers(struct BkPreforkClient *client)
+{
+    if (nullptr == client || nullptr == client->WorkerMain)
+        return BK_ERR_FORBIDDEN;
+
+    AppImpl &app = AppImpl::Get();
+    if (BK_APP_MAINTHREAD_MODE != app.Mode())
+    {
+        NOTREACHED();
+        return BK_ERR_FORBIDDEN;
+    }
+
+    PreforkSupervisor supervisor(*client);
+    {
+        std::unique_lock<std::mutex> lock(g_supervisorLock);
+        if (nullptr != g_supervisor)
+            return BK_ERR_FORBIDDEN;
+        g_supervisor = &supervisor;
+    }
+
+    int ret = supervisor.Run();
+
+    // Waits for the exports still using the supervisor.
+    std::unique_lock<std::mutex> lock(g_supervisorLock);
+    g_supervisor = nullptr;
+    return ret;
+}
+
+BKEXPORT void BKAPI BkStopPreforkWorkers(void)
+{
+    std::unique_lock<std::mutex> lock(g_supervisorLock);
+    if (nullptr != g_supervisor)
+        g_supervisor->Stop();
+}
+
+} // extern "C"
@@ -0,0 +1,58 @@
+// -------------------------------------------------
+// BlinKit - BlinKit Library
+// -------------------------------------------------
+//   File Name: prefork_supervisor.h
+// Description: PreforkSupervisor Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINKIT_PREFORK_SUPERVISOR_H
+#define BLINKIT_BLINKIT_PREFORK_SUPERVISOR_H
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <sys/types.h>
+#include "bk_app.h"
+
+namespace BlinKit {
+
+// Forks worker processes from an initialized engine, so that they share its
+// state copy-on-write, then waits for them in the parent and restarts the ones
+// which crashed.
+class PreforkSupervisor
+{
+public:
+    PreforkSupervisor(const BkPreforkClient &client);
+
+    // Parent only, returns when all the workers are gone.
+    int Run(void);
+    void Stop(void);
+
+    unsigned GetStats(BkWorkerStats *stats, unsigned count) const;
+private:
+    // Never returns in the worker.
+    bool Spawn(unsigned index);
+    bool ShouldRestart(unsigned index, int status) const;
+    void FillStats(unsigned index, BkWorkerStats &stats) const;
+
+    struct Worker {
+        pid_t pid = 0;
+        unsigned restarts = 0;
+        int lastStatus = 0;
+    };
+
+    BkPreforkClient m_client;
+    mutable std::mutex m_lock;
+    std::vector<Worker> m_workers;
+    std::atomic<bool> m_stopping{ false };
+};
+
+} // namespace BlinKit
+
+#endif // BLINKIT_BLINKIT_PREFORK_SUPERVISOR_H
@@ -11,6 +11,9 @@
 
 #include "task_loop.h"
 
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
 #include "blinkit/blink_impl/posix_task_runner.h"
 
 namespace BlinKit {
@@ -32,7 +35,43 @@ private:
     const std::function<void()> m_task;
 };
 
-TaskLoop::TaskLoop(void)
+class TaskLoop::Owner
+{
+public:
+    Owner(TaskLoop *loop) : m_loop(loop) { pthread_mutex_init(&m_lock, nullptr); }
+    ~Owner(void) { pthread_mutex_destroy(&m_lock); }
+
+    void Detach(void)
+    {
+        pthread_mutex_lock(&m_lock);
+        m_loop = nullptr;
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    void PostTask(const base::Location &location, const std::function<void()> &task)
+    {
+        pthread_mutex_lock(&m_lock);
+        if (nullptr != m_loop)
+            m_loop->PostTask(location, task);
+        pthread_mutex_unlock(&m_lock);
+    }
+
+    void Lock(void) { pthread_mutex_lock(&m_lock); }
+    void Unlock(void) { pthread_mutex_unlock(&m_lock); }
+    void Renew(void) { pthread_mutex_init(&m_lock, nullptr); }
+private:
+    pthread_mutex_t m_lock;
+    TaskLoop *m_loop;
+};
+
+static int64_t MonotonicTimeInUs(void)
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return static_cast<int64_t>(t.tv_sec) * 1000000 + t.tv_nsec / 1000;
+}
+
+TaskLoop::TaskLoop(void) : m_owner(std::make_shared<Owner>(this)), m_eventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
 {
     pthread_mutex_init(&m_mutex, nullptr);
     pthread_cond_init(&m_cond, nullptr);
@@ -40,6 +79,11 @@ TaskLoop::TaskLoop(void)
 
 TaskLoop::~TaskLoop(void)
 {
+    // Waits for the posts in progress.
+    m_owner->Detach();
+
+    if (m_eventFd >= 0)
+        close(m_eventFd);
     pthread_cond_destroy(&m_cond);
     pthread_mutex_destroy(&m_mutex);
 
@@ -63,17 +107,101 @@ void TaskLoop::Exit(int code)
 
 std::shared_ptr<base::SingleThreadTaskRunner> TaskLoop::GetTaskRunner(void)
 {
-    const auto taskPoster = [this](const base::Location &location, const std::function<void()> &task)
+    std::shared_ptr<Owner> owner = m_owner;
+    const auto taskPoster = [owner](const base::Location &location, const std::function<void()> &task)
     {
-        TaskData *taskData = new TaskData(location, task);
-        pthread_mutex_lock(&m_mutex);
-        m_taskQueue.push(taskData);
-        pthread_cond_signal(&m_cond);
-        pthread_mutex_unlock(&m_mutex);
+        owner->PostTask(location, task);
     };
     return std::make_shared<PosixTaskRunner>(taskPoster);
 }
 
+bool TaskLoop::Pump(int64_t budgetInUs)
+{
+    // Consume the notifications first, tasks posted from now on signal the descriptor again.
+    if (m_eventFd >= 0)
+    {
+        uint64_t n;
+        read(m_eventFd, &n, sizeof(n));
+    }
+
+    const int64_t deadline = MonotonicTimeInUs() + budgetInUs;
+    for (;;)
+    {
+        TaskData *taskData = nullptr;
+
+        pthread_mutex_lock(&m_mutex);
+        if (!m_taskQueue.empty())
+        {
+            taskData = m_taskQueue.front();
+            m_taskQueue.pop();
+        }
+        pthread_mutex_unlock(&m_mutex);
+
+        if (nullptr == taskData)
+            return false;
+        delete taskData;
+
+        if (MonotonicTimeInUs() >= deadline)
+            break;
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    const bool hasMore = !m_taskQueue.empty();
+    pthread_mutex_unlock(&m_mutex);
+
+    // Keep the descriptor readable for what is left.
+    if (hasMore && m_eventFd >= 0)
+    {
+        uint64_t n = 1;
+        write(m_eventFd, &n, sizeof(n));
+    }
+    return hasMore;
+}
+
+void TaskLoop::PostTask(const base::Location &location, const std::function<void()> &task)
+{
+    TaskData *taskData = new TaskData(location, task);
+    pthread_mutex_lock(&m_mutex);
+    m_taskQueue.push(taskData);
+    pthread_cond_signal(&m_cond);
+    pthread_mutex_unlock(&m_mutex);
+
+    if (m_eventFd >= 0)
+    {
+        uint64_t n = 1;
+        write(m_eventFd, &n, sizeof(n));
+    }
+}
+
+void TaskLoop::PrepareForFork(void)
+{
+    m_owner->Lock();
+    pthread_mutex_lock(&m_mutex);
+}
+
+void TaskLoop::ResumeAfterFork(bool inChild)
+{
+    if (!inChild)
+    {
+        pthread_mutex_unlock(&m_mutex);
+        m_owner->Unlock();
+        return;
+    }
+
+    m_owner->Renew();
+    pthread_mutex_init(&m_mutex, nullptr);
+    pthread_cond_init(&m_cond, nullptr);
+
+    if (m_eventFd >= 0)
+        close(m_eventFd);
+    m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!m_taskQueue.empty() && m_eventFd >= 0)
+    {
+        uint64_t n = 1;
+        write(m_eventFd, &n, sizeof(n));
+    }
+}
+
 int TaskLoop::Run(void)
 {
     for (;;)
@@ -14,11 +14,14 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <optional>
 #include <pthread.h>
 #include <queue>
 
 namespace base {
+class Location;
 class SingleThreadTaskRunner;
 }
 
@@ -33,10 +36,27 @@ public:
     int Run(void);
     void Exit(int code);
 
+    // Readable while tasks are ready, for embedding the loop into the host's poll loop.
+    int FileDescriptor(void) const { return m_eventFd; }
+    // Runs the ready tasks until the budget is used up, returns true if some are left.
+    bool Pump(int64_t budgetInUs);
+    // The queue is held from PrepareForFork to ResumeAfterFork, which renews the synchronization objects and the
+    // descriptor in a forked child.
+    void PrepareForFork(void);
+    void ResumeAfterFork(bool inChild);
+
     std::shared_ptr<base::SingleThreadTaskRunner> GetTaskRunner(void);
 private:
+    void PostTask(const base::Location &location, const std::function<void()> &task);
+
+    // Shared with the task runners, which may outlive the loop, e.g. in delay threads. Tasks posted after the loop
+    // is gone are dropped.
+    class Owner;
+    const std::shared_ptr<Owner> m_owner;
+
     pthread_mutex_t m_mutex;
     pthread_cond_t m_cond;
+    int m_eventFd;
     std::optional<int> m_exitCode;
 
     class TaskData;
@@ -47,6 +47,7 @@ public:
     static TimeDelta FromMicroseconds(int64_t us);
 
     double InSecondsF(void) const;
+    int64_t InMicroseconds(void) const { return m_delta; }
     int64_t InMilliseconds(void) const;
     double InMillisecondsF(void) const;
 
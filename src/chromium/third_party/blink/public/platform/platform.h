@@ -68,6 +68,9 @@ public:
     static Platform* Current(void);
 
     Thread* CurrentThread(void);
+    // For the engine threads of the pool mode, called on the threads themselves.
+    void AttachThread(Thread *thread);
+    void DetachThread(Thread *thread);
 
     virtual WTF::String DefaultLocale(void) { return String("en-US"); }
     virtual std::unique_ptr<WebURLLoader> CreateURLLoader(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner);
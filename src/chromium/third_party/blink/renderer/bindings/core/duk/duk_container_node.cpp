@@ -16,6 +16,7 @@
 #include "third_party/blink/renderer/bindings/core/duk/duk_html_collection.h"
 #include "third_party/blink/renderer/bindings/core/duk/duk_node_list.h"
 #include "third_party/blink/renderer/core/dom/static_node_list.h"
+#include "third_party/blink/renderer/core/editing/serializers/visible_text.h"
 
 using namespace blink;
 
@@ -35,6 +36,17 @@ static duk_ret_t GetElementsByTagName(duk_context *ctx)
     return 1;
 }
 
+static duk_ret_t GetVisibleText(duk_context *ctx)
+{
+    duk_push_this(ctx);
+    ContainerNode *node = DukScriptObject::To<ContainerNode>(ctx, -1);
+
+    std::string text;
+    AppendVisibleTextUTF8(text, *node);
+    Duk::PushString(ctx, text);
+    return 1;
+}
+
 static duk_ret_t QuerySelector(duk_context *ctx)
 {
     const AtomicString selectors = Duk::To<AtomicString>(ctx, 0);
@@ -73,14 +85,50 @@ static duk_ret_t QuerySelectorAll(duk_context *ctx)
     return 1;
 }
 
+static duk_ret_t QuerySelectorAllBatch(duk_context *ctx)
+{
+    if (!duk_is_array(ctx, 0))
+        duk_error(ctx, DUK_ERR_TYPE_ERROR, "An array of selectors is expected.");
+
+    std::vector<AtomicString> selectors;
+    duk_size_t length = duk_get_length(ctx, 0);
+    for (duk_size_t i = 0; i < length; ++i)
+    {
+        duk_get_prop_index(ctx, 0, i);
+        selectors.emplace_back(Duk::To<AtomicString>(ctx, -1));
+        duk_pop(ctx);
+    }
+
+    duk_push_this(ctx);
+    ContainerNode *node = DukScriptObject::To<ContainerNode>(ctx, -1);
+
+    DukExceptionState exceptionState(ctx);
+    std::vector<StaticElementList *> lists = node->querySelectorAllBatch(selectors, exceptionState);
+    if (exceptionState.HadException())
+    {
+        exceptionState.ThrowIfNeeded();
+        return 0;
+    }
+
+    duk_idx_t idx = duk_push_array(ctx);
+    for (size_t i = 0; i < lists.size(); ++i)
+    {
+        DukNodeList::Push(ctx, lists[i]);
+        duk_put_prop_index(ctx, idx, i);
+    }
+    return 1;
+}
+
 } // namespace Impl
 
 void DukContainerNode::FillPrototypeEntry(PrototypeEntry &entry)
 {
     static const PrototypeEntry::Method Methods[] = {
         { "getElementsByTagName",   Impl::GetElementsByTagName,   1 },
+        { "getVisibleText",         Impl::GetVisibleText,         0 },
         { "querySelector",          Impl::QuerySelector,          1 },
         { "querySelectorAll",       Impl::QuerySelectorAll,       1 },
+        { "querySelectorAllBatch",  Impl::QuerySelectorAllBatch,  1 },
     };
 
     DukNode::FillPrototypeEntry(entry);
@@ -16,6 +16,7 @@
 #include "third_party/blink/renderer/bindings/core/duk/duk_exception_state.h"
 #include "third_party/blink/renderer/bindings/core/duk/duk_named_node_map.h"
 #include "third_party/blink/renderer/bindings/core/duk/duk_script_element.h"
+#include "third_party/blink/renderer/core/editing/serializers/serialization.h"
 #include "third_party/blink/renderer/platform/bindings/script_wrappers.h"
 #include "third_party/blink/renderer/platform/wtf/wtf.h"
 
@@ -54,7 +55,10 @@ static duk_ret_t InnerHTMLGetter(duk_context *ctx)
 {
     duk_push_this(ctx);
     Element *element = DukScriptObject::To<Element>(ctx, -1);
-    Duk::PushString(ctx, element->innerHTML());
+
+    std::string html;
+    AppendMarkupUTF8(html, *element, kChildrenOnly);
+    Duk::PushString(ctx, html);
     return 1;
 }
 
@@ -137,16 +141,10 @@ void DukElement::FillPrototypeEntryForCrawler(PrototypeEntry &entry)
 
 const std::unordered_map<std::string, const char *>& DukElement::PrototypeMapForCrawler(void)
 {
-    static std::unordered_map<std::string, const char *> s_prototypeMapForCrawler;
-
-    ASSERT(IsMainThread());
-    if (s_prototypeMapForCrawler.empty())
-    {
-        s_prototypeMapForCrawler.insert({
-            { "script", DukScriptElement::ProtoName }
-        });
-    }
-
+    // Built once, and read only afterwards, by all the engine threads.
+    static const std::unordered_map<std::string, const char *> s_prototypeMapForCrawler = {
+        { "script", DukScriptElement::ProtoName }
+    };
     return s_prototypeMapForCrawler;
 }
 
@@ -120,7 +120,11 @@ bool ScriptController::ScriptEnabled(void)
 void ScriptController::UpdateDocument(void)
 {
     if (m_context)
+    {
         m_context->Reset();
+        // The heap is kept for the new document, drop the cycles the previous one left.
+        m_context->CollectGarbage();
+    }
 }
 
 } // namespace blink
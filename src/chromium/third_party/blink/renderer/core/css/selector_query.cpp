@@ -41,6 +41,7 @@
 #include "third_party/blink/renderer/core/css/parser/css_parser.h"
 #include "third_party/blink/renderer/core/css/selector_checker.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element_index.h"
 #include "third_party/blink/renderer/core/dom/element_traversal.h"
 #include "third_party/blink/renderer/core/dom/nth_index_cache.h"
 #include "third_party/blink/renderer/core/dom/static_node_list.h"
@@ -97,6 +98,22 @@ template <typename SelectorQueryTrait>
 static void CollectElementsByTagName(ContainerNode &rootNode, const QualifiedName &tagName, typename SelectorQueryTrait::OutputType &output)
 {
     ASSERT(tagName.NamespaceURI() == g_star_atom);
+    if (rootNode.IsInDocumentTree() && tagName.LocalName() != g_star_atom)
+    {
+        ElementIndex::Range candidates = rootNode.GetDocument().EnsureElementIndex().ElementsWithLocalName(rootNode, tagName.LocalName());
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            Element &element = **it;
+            if (MatchesTagName(tagName, element))
+            {
+                SelectorQueryTrait::AppendElement(output, element);
+                if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
+                    return;
+            }
+        }
+        return;
+    }
+
     for (Element &element : ElementTraversal::DescendantsOf(rootNode))
     {
         if (MatchesTagName(tagName, element))
@@ -119,6 +136,54 @@ inline bool SelectorMatches(const CSSSelector &selector, Element &element, const
     return checker.Match(context);
 }
 
+template <typename SelectorQueryTrait>
+static void CollectElementsByClassName(
+    ContainerNode &rootNode,
+    const AtomicString &className,
+    const CSSSelector *selector,
+    typename SelectorQueryTrait::OutputType &output)
+{
+    if (rootNode.IsInDocumentTree())
+    {
+        ElementIndex::Range candidates = rootNode.GetDocument().EnsureElementIndex().ElementsWithClassName(rootNode, className);
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            Element &element = **it;
+            ASSERT(element.HasClassName(className));
+            if (nullptr != selector && !SelectorMatches(*selector, element, rootNode))
+                continue;
+            SelectorQueryTrait::AppendElement(output, element);
+            if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
+                return;
+        }
+        return;
+    }
+
+    for (Element &element : ElementTraversal::DescendantsOf(rootNode))
+    {
+        if (!element.HasClassName(className))
+            continue;
+        if (nullptr != selector && !SelectorMatches(*selector, element, rootNode))
+            continue;
+        SelectorQueryTrait::AppendElement(output, element);
+        if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
+            return;
+    }
+}
+
+// Returns the type selector of the rightmost compound selector, if any.
+static const CSSSelector* RightmostTagSelector(const CSSSelector &selector)
+{
+    for (const CSSSelector *current = &selector; nullptr != current; current = current->TagHistory())
+    {
+        if (current->Match() == CSSSelector::kTag && current->TagQName().LocalName() != g_star_atom)
+            return current;
+        if (current->Relation() != CSSSelector::kSubSelector)
+            break;
+    }
+    return nullptr;
+}
+
 SelectorQuery::SelectorQuery(CSSSelectorList selectorList)
     : m_selectorList(std::move(selectorList))
     , m_selectorIdIsRightmost(true)
@@ -178,15 +243,9 @@ void SelectorQuery::Execute(ContainerNode &rootNode, typename SelectorQueryTrait
 
     if (m_useSlowScan)
     {
-        ASSERT(false); // BKTODO:
-#if 0
-        if (m_needsUpdatedDistribution)
-            rootNode.UpdateDistributionForFlatTreeTraversal();
-        if (m_usesDeepCombinatorOrShadowPseudo)
-            ExecuteSlowTraversingShadowTree<SelectorQueryTrait>(rootNode, output);
-        else
-            ExecuteSlow<SelectorQueryTrait>(rootNode, output);
-#endif
+        ASSERT(!m_needsUpdatedDistribution);
+        ASSERT(!m_usesDeepCombinatorOrShadowPseudo);
+        ExecuteSlow<SelectorQueryTrait>(rootNode, output);
         return;
     }
 
@@ -214,10 +273,7 @@ void SelectorQuery::Execute(ContainerNode &rootNode, typename SelectorQueryTrait
         switch (firstSelector.Match())
         {
         case CSSSelector::kClass:
-            ASSERT(false); // BKTODO:
-#if 0
             CollectElementsByClassName<SelectorQueryTrait>(rootNode, firstSelector.Value(), nullptr, output);
-#endif
             return;
         case CSSSelector::kTag:
             if (firstSelector.TagQName().NamespaceURI() == g_star_atom)
@@ -238,6 +294,23 @@ void SelectorQuery::Execute(ContainerNode &rootNode, typename SelectorQueryTrait
     FindTraverseRootsAndExecute<SelectorQueryTrait>(rootNode, output);
 }
 
+template <typename SelectorQueryTrait>
+void SelectorQuery::ExecuteSlow(ContainerNode &rootNode, typename SelectorQueryTrait::OutputType &output) const
+{
+    for (Element &element : ElementTraversal::DescendantsOf(rootNode))
+    {
+        for (const CSSSelector *selector : m_selectors)
+        {
+            if (!SelectorMatches(*selector, element, rootNode))
+                continue;
+            SelectorQueryTrait::AppendElement(output, element);
+            if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
+                return;
+            break;
+        }
+    }
+}
+
 template <typename SelectorQueryTrait>
 void SelectorQuery::ExecuteForTraverseRoot(ContainerNode &traverseRoot, ContainerNode &rootNode, typename SelectorQueryTrait::OutputType &output) const
 {
@@ -286,10 +359,7 @@ void SelectorQuery::FindTraverseRootsAndExecute(ContainerNode &rootNode, typenam
         {
             if (isRightmostSelector)
             {
-                ASSERT(false); // BKTODO:
-#if 0
                 CollectElementsByClassName<SelectorQueryTrait>(rootNode, selector->Value(), m_selectors[0], output);
-#endif
                 return;
             }
             // Since there exists some ancestor element which has the class name, we
@@ -324,17 +394,41 @@ void SelectorQuery::FindTraverseRootsAndExecute(ContainerNode &rootNode, typenam
             || selector->Relation() == CSSSelector::kIndirectAdjacent;
     }
 
+    // Seed the candidates from the type selector of the rightmost compound, so
+    // that 'ul > li' only looks at <li> elements.
+    const CSSSelector *tagSelector = RightmostTagSelector(*m_selectors[0]);
+    if (nullptr != tagSelector && rootNode.IsInDocumentTree())
+    {
+        const QualifiedName &tagName = tagSelector->TagQName();
+        ElementIndex::Range candidates = rootNode.GetDocument().EnsureElementIndex().ElementsWithLocalName(rootNode, tagName.LocalName());
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            Element &element = **it;
+            if (!SelectorMatches(*m_selectors[0], element, rootNode))
+                continue;
+            SelectorQueryTrait::AppendElement(output, element);
+            if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
+                return;
+        }
+        return;
+    }
+
     ExecuteForTraverseRoot<SelectorQueryTrait>(rootNode, rootNode, output);
 }
 
 StaticElementList* SelectorQuery::QueryAll(ContainerNode &rootNode) const
 {
-    NthIndexCache nthIndexCache(rootNode.GetDocument());
     std::vector<Element *> result;
-    Execute<AllElementsSelectorQueryTrait>(rootNode, result);
+    QueryAll(rootNode, result);
     return StaticElementList::Adopt(result);
 }
 
+void SelectorQuery::QueryAll(ContainerNode &rootNode, std::vector<Element *> &result) const
+{
+    NthIndexCache nthIndexCache(rootNode.GetDocument());
+    Execute<AllElementsSelectorQueryTrait>(rootNode, result);
+}
+
 Element* SelectorQuery::QueryFirst(ContainerNode &rootNode) const
 {
     NthIndexCache nthIndexCache(rootNode.GetDocument());
@@ -345,6 +439,148 @@ Element* SelectorQuery::QueryFirst(ContainerNode &rootNode) const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+MultiSelectorQuery::MultiSelectorQuery(std::vector<CSSSelectorList> &selectorLists, bool inQuirksMode)
+    : m_selectorLists(std::move(selectorLists))
+{
+    for (unsigned i = 0; i < m_selectorLists.size(); ++i)
+    {
+        const CSSSelectorList &selectorList = m_selectorLists[i];
+        for (const CSSSelector *selector = selectorList.First(); nullptr != selector; selector = CSSSelectorList::Next(*selector))
+        {
+            if (selector->MatchesPseudoElement())
+                continue;
+            AddSelector(*selector, i, inQuirksMode);
+        }
+    }
+}
+
+void MultiSelectorQuery::AddSelector(const CSSSelector &selector, unsigned index, bool inQuirksMode)
+{
+    const Entry entry = { &selector, index };
+
+    // Pick the most selective key of the rightmost compound, ids and class names
+    // are not used in quirks mode as they are matched case-insensitively there.
+    const CSSSelector *idSelector = nullptr, *classSelector = nullptr, *tagSelector = nullptr;
+    for (const CSSSelector *current = &selector; nullptr != current; current = current->TagHistory())
+    {
+        switch (current->Match())
+        {
+            case CSSSelector::kId:
+                if (nullptr == idSelector)
+                    idSelector = current;
+                break;
+            case CSSSelector::kClass:
+                if (nullptr == classSelector)
+                    classSelector = current;
+                break;
+            case CSSSelector::kTag:
+                if (current->TagQName().LocalName() != g_star_atom)
+                    tagSelector = current;
+                break;
+            default:
+                break;
+        }
+        if (current->Relation() != CSSSelector::kSubSelector)
+            break;
+    }
+
+    if (nullptr != idSelector && !inQuirksMode)
+        m_idEntries[idSelector->Value()].push_back(entry);
+    else if (nullptr != classSelector && !inQuirksMode)
+        m_classEntries[classSelector->Value()].push_back(entry);
+    else if (nullptr != tagSelector)
+        m_tagEntries[tagSelector->TagQName().LocalName().LowerASCII()].push_back(entry);
+    else
+        m_universalEntries.push_back(entry);
+}
+
+std::unique_ptr<MultiSelectorQuery> MultiSelectorQuery::Create(
+    const std::vector<AtomicString> &selectors,
+    const Document &document,
+    ExceptionState &exceptionState)
+{
+    std::unique_ptr<CSSParserContext> context(CSSParserContext::Create(document, document.BaseURL(), false, WTF::TextEncoding(), CSSParserContext::kSnapshotProfile));
+
+    std::vector<CSSSelectorList> selectorLists;
+    selectorLists.reserve(selectors.size());
+    for (const AtomicString &selector : selectors)
+    {
+        if (selector.IsEmpty())
+        {
+            exceptionState.ThrowDOMException(DOMExceptionCode::kSyntaxError, "The provided selector is empty.");
+            return nullptr;
+        }
+
+        CSSSelectorList selectorList = CSSParser::ParseSelector(context.get(), nullptr, selector);
+        if (nullptr == selectorList.First())
+        {
+            exceptionState.ThrowDOMException(DOMExceptionCode::kSyntaxError,
+                "'" + selector + "' is not a valid selector.");
+            return nullptr;
+        }
+        selectorLists.push_back(std::move(selectorList));
+    }
+
+    return base::WrapUnique(new MultiSelectorQuery(selectorLists, document.InQuirksMode()));
+}
+
+void MultiSelectorQuery::MatchEntries(
+    const EntryList &entries,
+    Element &element,
+    const ContainerNode &rootNode,
+    std::vector<std::vector<Element *>> &results)
+{
+    for (const Entry &entry : entries)
+    {
+        std::vector<Element *> &matches = results[entry.index];
+        // Already matched by another selector of the same list.
+        if (!matches.empty() && matches.back() == &element)
+            continue;
+        if (SelectorMatches(*entry.selector, element, rootNode))
+            matches.push_back(&element);
+    }
+}
+
+std::vector<std::vector<Element *>> MultiSelectorQuery::QueryAll(ContainerNode &rootNode) const
+{
+    NthIndexCache nthIndexCache(rootNode.GetDocument());
+
+    std::vector<std::vector<Element *>> results(m_selectorLists.size());
+    for (Element &element : ElementTraversal::DescendantsOf(rootNode))
+    {
+        if (!m_idEntries.empty() && element.HasID())
+        {
+            auto it = m_idEntries.find(element.GetIdAttribute());
+            if (std::end(m_idEntries) != it)
+                MatchEntries(it->second, element, rootNode, results);
+        }
+
+        if (!m_classEntries.empty() && element.HasClass())
+        {
+            const SpaceSplitString &classNames = element.ClassNames();
+            for (wtf_size_t i = 0; i < classNames.size(); ++i)
+            {
+                auto it = m_classEntries.find(classNames[i]);
+                if (std::end(m_classEntries) != it)
+                    MatchEntries(it->second, element, rootNode, results);
+            }
+        }
+
+        if (!m_tagEntries.empty())
+        {
+            const AtomicString &localName = element.localName();
+            auto it = m_tagEntries.find(element.IsHTMLElement() ? localName : localName.LowerASCII());
+            if (std::end(m_tagEntries) != it)
+                MatchEntries(it->second, element, rootNode, results);
+        }
+
+        MatchEntries(m_universalEntries, element, rootNode, results);
+    }
+    return results;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 SelectorQuery* SelectorQueryCache::Add(const AtomicString &selectors, const Document &document, ExceptionState &exceptionState)
 {
     if (selectors.IsEmpty())
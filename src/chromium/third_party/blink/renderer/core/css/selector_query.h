@@ -64,6 +64,8 @@ public:
 
     // https://dom.spec.whatwg.org/#dom-parentnode-queryselectorall
     StaticElementList* QueryAll(ContainerNode &rootNode) const;
+    // Same as above, for native callers which do not need a NodeList.
+    void QueryAll(ContainerNode &rootNode, std::vector<Element *> &result) const;
 
     // https://dom.spec.whatwg.org/#dom-parentnode-queryselector
     Element* QueryFirst(ContainerNode &rootNode) const;
@@ -73,6 +75,8 @@ private:
     template <typename SelectorQueryTrait>
     void Execute(ContainerNode &rootNode, typename SelectorQueryTrait::OutputType &output) const;
     template <typename SelectorQueryTrait>
+    void ExecuteSlow(ContainerNode &rootNode, typename SelectorQueryTrait::OutputType &output) const;
+    template <typename SelectorQueryTrait>
     void ExecuteForTraverseRoot(ContainerNode &traverseRoot, ContainerNode &rootNode, typename SelectorQueryTrait::OutputType &output) const;
     template <typename SelectorQueryTrait>
     void FindTraverseRootsAndExecute(ContainerNode &rootNode, typename SelectorQueryTrait::OutputType &output) const;
@@ -92,6 +96,41 @@ private:
     DISALLOW_COPY_AND_ASSIGN(SelectorQuery);
 };
 
+// Evaluates a batch of selectors with a single walk over the tree. Selectors
+// are bucketed by a key of their rightmost compound (id, class or tag name),
+// so that each element is only checked against the selectors which can match.
+class MultiSelectorQuery
+{
+public:
+    // Throws a SyntaxError for the first invalid selector.
+    static std::unique_ptr<MultiSelectorQuery> Create(const std::vector<AtomicString> &selectors,
+        const Document &document, ExceptionState &exceptionState);
+
+    size_t size(void) const { return m_selectorLists.size(); }
+
+    // Returns the matched elements of each selector, in tree order.
+    std::vector<std::vector<Element *>> QueryAll(ContainerNode &rootNode) const;
+private:
+    MultiSelectorQuery(std::vector<CSSSelectorList> &selectorLists, bool inQuirksMode);
+
+    void AddSelector(const CSSSelector &selector, unsigned index, bool inQuirksMode);
+
+    struct Entry {
+        const CSSSelector *selector;
+        unsigned index;
+    };
+    typedef std::vector<Entry> EntryList;
+    static void MatchEntries(const EntryList &entries, Element &element, const ContainerNode &rootNode,
+        std::vector<std::vector<Element *>> &results);
+
+    std::vector<CSSSelectorList> m_selectorLists;
+    std::unordered_map<AtomicString, EntryList> m_idEntries;
+    std::unordered_map<AtomicString, EntryList> m_classEntries;
+    std::unordered_map<AtomicString, EntryList> m_tagEntries;
+    EntryList m_universalEntries;
+    DISALLOW_COPY_AND_ASSIGN(MultiSelectorQuery);
+};
+
 class SelectorQueryCache
 {
 public:
@@ -834,6 +834,26 @@ StaticElementList* ContainerNode::querySelectorAll(const AtomicString &selectors
     return ret;
 }
 
+std::vector<StaticElementList *> ContainerNode::querySelectorAllBatch(
+    const std::vector<AtomicString> &selectors,
+    ExceptionState &exceptionState)
+{
+    std::vector<StaticElementList *> ret;
+
+    std::unique_ptr<MultiSelectorQuery> query = MultiSelectorQuery::Create(selectors, GetDocument(), exceptionState);
+    if (!query)
+        return ret;
+
+    GCPool &gcPool = GCPool::From(GetDocument());
+    for (std::vector<Element *> &elements : query->QueryAll(*this))
+    {
+        StaticElementList *list = StaticElementList::Adopt(elements);
+        gcPool.Save(*list);
+        ret.push_back(list);
+    }
+    return ret;
+}
+
 bool ContainerNode::RecheckNodeInsertionStructuralPrereq(const NodeVector &newChildren, const Node *next, ExceptionState &exceptionState)
 {
     ASSERT(false); // BKTODO:
@@ -88,6 +88,10 @@ public:
     HTMLCollection* getElementsByTagName(const AtomicString &qualifiedName);
     Element* querySelector(const AtomicString &selectors, ExceptionState &exceptionState);
     StaticElementList* querySelectorAll(const AtomicString &selectors, ExceptionState &exceptionState);
+    // Same as calling querySelectorAll for each of |selectors|, but the tree is
+    // only walked once.
+    std::vector<StaticElementList *> querySelectorAllBatch(const std::vector<AtomicString> &selectors,
+        ExceptionState &exceptionState);
 
     Node* FirstChild(void) const { return m_firstChild; }
     Node* LastChild(void) const { return m_lastChild; }
@@ -47,6 +47,7 @@
 #include "third_party/blink/renderer/core/dom/document_fragment.h"
 #include "third_party/blink/renderer/core/dom/document_parser.h"
 #include "third_party/blink/renderer/core/dom/element_data_cache.h"
+#include "third_party/blink/renderer/core/dom/element_index.h"
 #include "third_party/blink/renderer/core/dom/element_traversal.h"
 #include "third_party/blink/renderer/core/dom/events/event.h"
 #include "third_party/blink/renderer/core/dom/events/event_dispatch_forbidden_scope.h"
@@ -739,6 +740,13 @@ void Document::ElementDataCacheClearTimerFired(TimerBase *)
     m_elementDataCache.reset();
 }
 
+ElementIndex& Document::EnsureElementIndex(void)
+{
+    if (!m_elementIndex)
+        m_elementIndex = ElementIndex::Create(*this);
+    return *m_elementIndex;
+}
+
 LocalFrame* Document::ExecutingFrame(void)
 {
     if (LocalDOMWindow *window = ExecutingWindow())
@@ -71,6 +71,7 @@ class DocumentLoader;
 class DocumentParser;
 class DocumentType;
 class ElementDataCache;
+class ElementIndex;
 class LayoutView;
 class LocalDOMWindow;
 class LocalFrame;
@@ -200,6 +201,9 @@ public:
     }
 
     ElementDataCache* GetElementDataCache(void) { return m_elementDataCache.get(); }
+    // Null until the first indexed query, elements update it only if it exists.
+    ElementIndex* GetElementIndex(void) const { return m_elementIndex.get(); }
+    ElementIndex& EnsureElementIndex(void);
     SelectorQueryCache& GetSelectorQueryCache(void);
 
     NthIndexCache* GetNthIndexCache(void) const { return m_nthIndexCache; }
@@ -418,6 +422,7 @@ private:
 #endif
 
     std::unique_ptr<ElementDataCache> m_elementDataCache;
+    std::unique_ptr<ElementIndex> m_elementIndex;
     std::unique_ptr<SelectorQueryCache> m_selectorQueryCache;
 
     // It is safe to keep a raw, untraced pointer to this stack-allocated
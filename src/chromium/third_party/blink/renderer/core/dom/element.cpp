@@ -41,6 +41,7 @@
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/element_data.h"
 #include "third_party/blink/renderer/core/dom/element_data_cache.h"
+#include "third_party/blink/renderer/core/dom/element_index.h"
 #include "third_party/blink/renderer/core/dom/element_rare_data.h"
 #include "third_party/blink/renderer/core/dom/mutation_observer_interest_group.h"
 #include "third_party/blink/renderer/core/dom/text.h"
@@ -302,6 +303,10 @@ void Element::ClassAttributeChanged(const AtomicString &newClassString)
     const ElementData *elementData = GetElementData();
     ASSERT(nullptr != elementData);
 
+    ElementIndex *elementIndex = IsInDocumentTree() ? GetDocument().GetElementIndex() : nullptr;
+    if (nullptr != elementIndex)
+        elementIndex->WillChangeClassNames(*this);
+
     ClassStringContent classStringContentType = ClassStringHasClassName(newClassString);
     const bool shouldFoldCase = GetDocument().InQuirksMode();
     if (classStringContentType == ClassStringContent::kHasClasses)
@@ -336,6 +341,9 @@ void Element::ClassAttributeChanged(const AtomicString &newClassString)
         else
             elementData->ClearClass();
     }
+
+    if (nullptr != elementIndex)
+        elementIndex->DidChangeClassNames(*this);
 }
 
 const SpaceSplitString& Element::ClassNames(void) const
@@ -707,6 +715,12 @@ Node::InsertionNotificationRequest Element::InsertedInto(ContainerNode &insertio
     if (!nameValue.IsNull())
         UpdateName(g_null_atom, nameValue);
 
+    if (IsInDocumentTree())
+    {
+        if (ElementIndex *elementIndex = GetDocument().GetElementIndex())
+            elementIndex->DidInsertElement(*this);
+    }
+
     return kInsertionDone;
 }
 
@@ -807,6 +821,17 @@ void Element::setAttribute(const AtomicString &localName, const AtomicString &va
     SetAttributeInternal(index, qName, value, kNotInSynchronizationOfLazyAttribute);
 }
 
+void Element::RemovedFrom(ContainerNode &insertionPoint)
+{
+    if (insertionPoint.IsInDocumentTree())
+    {
+        if (ElementIndex *elementIndex = GetDocument().GetElementIndex())
+            elementIndex->WillRemoveElement(*this);
+    }
+
+    ContainerNode::RemovedFrom(insertionPoint);
+}
+
 void Element::SetAttributeInternal(
     wtf_size_t index,
     const QualifiedName &name, const AtomicString &newValue,
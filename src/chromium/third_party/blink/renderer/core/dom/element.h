@@ -193,6 +193,7 @@ public:
     void DefaultEventHandler(Event &event) override;
 #endif
     InsertionNotificationRequest InsertedInto(ContainerNode &insertionPoint) override;
+    void RemovedFrom(ContainerNode &insertionPoint) override;
 protected:
     Element(const QualifiedName &tagName, Document *document, ConstructionType type);
 
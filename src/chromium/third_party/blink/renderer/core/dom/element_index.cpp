@@ -0,0 +1,216 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: element_index.cpp
+// Description: ElementIndex Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "element_index.h"
+
+#include <algorithm>
+#include <limits>
+#include "base/memory/ptr_util.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/element_traversal.h"
+
+namespace blink {
+
+static const uint64_t TreeOrderGap = 1 << 20;
+
+void ElementIndex::AddClassNames(Element &element)
+{
+    if (!element.HasClass())
+        return;
+
+    const SpaceSplitString &classNames = element.ClassNames();
+    for (wtf_size_t i = 0; i < classNames.size(); ++i)
+        AddToBucket(m_classNames, classNames[i], element);
+}
+
+void ElementIndex::AddToBucket(BucketMap &map, const AtomicString &key, Element &element)
+{
+    ElementList &list = map[key];
+
+    // Mostly appended, while the document is being parsed.
+    auto it = LowerBound(list, TreeOrderOf(element));
+    if (list.end() == it || *it != &element)
+        list.insert(it, &element);
+}
+
+void ElementIndex::AssignTreeOrder(const Element &element)
+{
+    // Inserted elements are notified in tree order, so the one before is mostly indexed already, unlike the ones
+    // after, which may be inserted along with this one.
+    uint64_t prevOrder = 0;
+    for (const Element *prev = ElementTraversal::Previous(element); nullptr != prev; prev = ElementTraversal::Previous(*prev))
+    {
+        auto it = m_treeOrder.find(prev);
+        if (std::end(m_treeOrder) != it)
+        {
+            prevOrder = it->second;
+            break;
+        }
+    }
+
+    uint64_t order;
+    auto next = m_elementsInTreeOrder.upper_bound(prevOrder);
+    if (std::end(m_elementsInTreeOrder) == next)
+    {
+        order = prevOrder + TreeOrderGap;
+    }
+    else if (next->first - prevOrder > 1)
+    {
+        order = prevOrder + (next->first - prevOrder) / 2;
+    }
+    else
+    {
+        RenumberTreeOrder();
+        AssignTreeOrder(element);
+        return;
+    }
+
+    m_treeOrder[&element] = order;
+    m_elementsInTreeOrder.emplace(order, &element);
+}
+
+std::unique_ptr<ElementIndex> ElementIndex::Create(Document &document)
+{
+    std::unique_ptr<ElementIndex> index = base::WrapUnique(new ElementIndex);
+    for (Element &element : ElementTraversal::DescendantsOf(document))
+        index->DidInsertElement(element);
+    return index;
+}
+
+void ElementIndex::DidChangeClassNames(Element &element)
+{
+    AddClassNames(element);
+}
+
+void ElementIndex::DidInsertElement(Element &element)
+{
+    ASSERT(element.IsInDocumentTree());
+    if (std::end(m_treeOrder) == m_treeOrder.find(&element))
+        AssignTreeOrder(element);
+    AddToBucket(m_localNames, LocalNameKey(element.localName()), element);
+    AddClassNames(element);
+}
+
+ElementIndex::Range ElementIndex::ElementsInBucket(const ContainerNode &rootNode, BucketMap &map, const AtomicString &key)
+{
+    ASSERT(rootNode.IsInDocumentTree());
+
+    static const ElementList s_emptyList;
+    auto it = map.find(key);
+    if (std::end(map) == it)
+        return Range(s_emptyList.begin(), s_emptyList.end());
+
+    ElementList &list = it->second;
+    if (rootNode.IsDocumentNode() || list.empty())
+        return Range(list.begin(), list.end());
+
+    // Descendants of |rootNode| are contiguous in tree order.
+    const Element &rootElement = ToElement(rootNode);
+    const Element *next = ElementTraversal::NextSkippingChildren(rootElement);
+    const uint64_t last = nullptr != next ? TreeOrderOf(*next) : std::numeric_limits<uint64_t>::max();
+
+    auto begin = LowerBound(list, TreeOrderOf(rootElement) + 1);
+    auto end = std::lower_bound(begin, list.end(), last, [this](const Element *element, uint64_t order) {
+        return TreeOrderOf(*element) < order;
+    });
+    return Range(begin, end);
+}
+
+ElementIndex::Range ElementIndex::ElementsWithClassName(const ContainerNode &rootNode, const AtomicString &className)
+{
+    return ElementsInBucket(rootNode, m_classNames, className);
+}
+
+ElementIndex::Range ElementIndex::ElementsWithLocalName(const ContainerNode &rootNode, const AtomicString &localName)
+{
+    return ElementsInBucket(rootNode, m_localNames, LocalNameKey(localName));
+}
+
+ElementIndex::ElementList::iterator ElementIndex::LowerBound(ElementList &list, uint64_t order) const
+{
+    return std::lower_bound(list.begin(), list.end(), order, [this](const Element *element, uint64_t value) {
+        return TreeOrderOf(*element) < value;
+    });
+}
+
+AtomicString ElementIndex::LocalNameKey(const AtomicString &localName)
+{
+    // Non-HTML elements keep their camel-cased names, while type selectors are
+    // lower-cased in HTML documents.
+    return localName.LowerASCII();
+}
+
+void ElementIndex::RemoveClassNames(Element &element)
+{
+    if (!element.HasClass())
+        return;
+
+    const SpaceSplitString &classNames = element.ClassNames();
+    for (wtf_size_t i = 0; i < classNames.size(); ++i)
+        RemoveFromBucket(m_classNames, classNames[i], element);
+}
+
+void ElementIndex::RemoveFromBucket(BucketMap &map, const AtomicString &key, Element &element)
+{
+    auto it = map.find(key);
+    if (std::end(map) == it)
+        return;
+
+    ElementList &list = it->second;
+    auto e = LowerBound(list, TreeOrderOf(element));
+    if (list.end() == e || *e != &element)
+        return;
+
+    list.erase(e);
+    if (list.empty())
+        map.erase(it);
+}
+
+void ElementIndex::RenumberTreeOrder(void)
+{
+    // Spreads the positions out, the order itself stays.
+    std::map<uint64_t, const Element *> elementsInTreeOrder;
+    uint64_t order = 0;
+    for (const auto &it : m_elementsInTreeOrder)
+    {
+        order += TreeOrderGap;
+        m_treeOrder[it.second] = order;
+        elementsInTreeOrder.emplace_hint(elementsInTreeOrder.end(), order, it.second);
+    }
+    m_elementsInTreeOrder.swap(elementsInTreeOrder);
+}
+
+uint64_t ElementIndex::TreeOrderOf(const Element &element) const
+{
+    auto it = m_treeOrder.find(&element);
+    ASSERT(std::end(m_treeOrder) != it);
+    return it->second;
+}
+
+void ElementIndex::WillChangeClassNames(Element &element)
+{
+    RemoveClassNames(element);
+}
+
+void ElementIndex::WillRemoveElement(Element &element)
+{
+    RemoveFromBucket(m_localNames, LocalNameKey(element.localName()), element);
+    RemoveClassNames(element);
+
+    auto it = m_treeOrder.find(&element);
+    if (std::end(m_treeOrder) != it)
+    {
+        m_elementsInTreeOrder.erase(it->second);
+        m_treeOrder.erase(it);
+    }
+}
+
+} // namespace blink
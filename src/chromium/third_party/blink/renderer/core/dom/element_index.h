@@ -0,0 +1,82 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: element_index.h
+// Description: ElementIndex Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINK_ELEMENT_INDEX_H
+#define BLINKIT_BLINK_ELEMENT_INDEX_H
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "third_party/blink/renderer/platform/wtf/text/atomic_string.h"
+
+namespace blink {
+
+class ContainerNode;
+class Document;
+class Element;
+
+// Document-wide inverted indexes from class names and local names to the
+// elements in the document tree. Created on the first query and maintained
+// incrementally afterwards, see Document::EnsureElementIndex.
+class ElementIndex
+{
+public:
+    static std::unique_ptr<ElementIndex> Create(Document &document);
+
+    void DidInsertElement(Element &element);
+    void WillRemoveElement(Element &element);
+    void WillChangeClassNames(Element &element);
+    void DidChangeClassNames(Element &element);
+
+    typedef std::vector<Element *> ElementList;
+    typedef std::pair<ElementList::const_iterator, ElementList::const_iterator> Range;
+
+    // Returns the indexed elements which are descendants of |rootNode|, in tree
+    // order. |rootNode| must be in the document tree.
+    Range ElementsWithClassName(const ContainerNode &rootNode, const AtomicString &className);
+    // Matching is case-insensitive, callers still need to check the tag name.
+    Range ElementsWithLocalName(const ContainerNode &rootNode, const AtomicString &localName);
+private:
+    ElementIndex(void) = default;
+
+    // Buckets are kept in tree order.
+    typedef std::unordered_map<AtomicString, ElementList> BucketMap;
+
+    static AtomicString LocalNameKey(const AtomicString &localName);
+    void AddToBucket(BucketMap &map, const AtomicString &key, Element &element);
+    void RemoveFromBucket(BucketMap &map, const AtomicString &key, Element &element);
+    void AddClassNames(Element &element);
+    void RemoveClassNames(Element &element);
+
+    Range ElementsInBucket(const ContainerNode &rootNode, BucketMap &map, const AtomicString &key);
+    ElementList::iterator LowerBound(ElementList &list, uint64_t order) const;
+    uint64_t TreeOrderOf(const Element &element) const;
+    void AssignTreeOrder(const Element &element);
+    void RenumberTreeOrder(void);
+
+    BucketMap m_classNames;
+    BucketMap m_localNames;
+
+    // Positions of the indexed elements in tree order, used to sort buckets and
+    // to narrow them down to a subtree. They are sparse: an inserted element
+    // takes a position between the ones of its neighbours, and all positions
+    // are spread out again only when there is no room left. Removing elements
+    // does not change the relative order of the others.
+    std::unordered_map<const Element *, uint64_t> m_treeOrder;
+    std::map<uint64_t, const Element *> m_elementsInTreeOrder;
+};
+
+} // namespace blink
+
+#endif // BLINKIT_BLINK_ELEMENT_INDEX_H
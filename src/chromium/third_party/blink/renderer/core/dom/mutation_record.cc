@@ -46,6 +46,7 @@
 #include "third_party/blink/renderer/core/dom/qualified_name.h"
 // BKTODO: #include "third_party/blink/renderer/core/dom/static_node_list.h"
 #include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
+#include "third_party/blink/renderer/platform/wtf/thread_specific.h"
 
 namespace blink {
 
@@ -182,18 +183,24 @@ class MutationRecordWithNullOldValue : public MutationRecord {
 };
 
 const AtomicString& ChildListRecord::type() {
-  DEFINE_STATIC_LOCAL(AtomicString, child_list, ("childList"));
-  return child_list;
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<AtomicString>, child_list, ());
+  if (child_list->IsNull())
+    *child_list = AtomicString("childList");
+  return *child_list;
 }
 
 const AtomicString& AttributesRecord::type() {
-  DEFINE_STATIC_LOCAL(AtomicString, attributes, ("attributes"));
-  return attributes;
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<AtomicString>, attributes, ());
+  if (attributes->IsNull())
+    *attributes = AtomicString("attributes");
+  return *attributes;
 }
 
 const AtomicString& CharacterDataRecord::type() {
-  DEFINE_STATIC_LOCAL(AtomicString, character_data, ("characterData"));
-  return character_data;
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<AtomicString>, character_data, ());
+  if (character_data->IsNull())
+    *character_data = AtomicString("characterData");
+  return *character_data;
 }
 
 }  // namespace
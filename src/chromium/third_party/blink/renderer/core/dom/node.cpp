@@ -54,6 +54,7 @@
 #include "third_party/blink/renderer/platform/bindings/gc_pool.h"
 #include "third_party/blink/renderer/platform/bindings/script_forbidden_scope.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+#include "third_party/blink/renderer/platform/wtf/thread_specific.h"
 #include "third_party/blink/renderer/platform/wtf/wtf.h"
 
 using namespace BlinKit;
@@ -64,8 +65,9 @@ using EventTargetDataMap = std::unordered_map<Node *, std::unique_ptr<EventTarge
 
 static EventTargetDataMap& GetEventTargetDataMap(void)
 {
-    static EventTargetDataMap s_eventTargetDataMap;
-    return s_eventTargetDataMap;
+    // Nodes live and die on their engine thread.
+    DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<EventTargetDataMap>, maps, ());
+    return *maps;
 }
 
 Node::Node(TreeScope *treeScope, ConstructionType type)
@@ -39,6 +39,7 @@
 #include "third_party/blink/renderer/platform/wtf/assertions.h"
 #include "third_party/blink/renderer/platform/wtf/hash_set.h"
 #include "third_party/blink/renderer/platform/wtf/static_constructors.h"
+#include "third_party/blink/renderer/platform/wtf/thread_specific.h"
 #include "third_party/blink/renderer/platform/wtf/wtf.h"
 
 namespace blink {
@@ -59,11 +60,48 @@ static_assert(sizeof(QualifiedName::QualifiedNameImpl) ==
 using QualifiedNameCache =
     HashSet<QualifiedName::QualifiedNameImpl*, QualifiedNameHash>;
 
+static QualifiedNameCache* g_initial_name_cache = nullptr;
+
 static QualifiedNameCache& GetQualifiedNameCache() {
-  // This code is lockless and thus assumes it all runs on one thread!
+  // This code is lockless, so each engine thread has a cache of its own. Like
+  // the AtomicStringTable, a new cache starts with the static names, which
+  // are registered on the initializing thread before any engine thread runs.
   DCHECK(IsMainThread());
-  static QualifiedNameCache* g_name_cache = new QualifiedNameCache;
-  return *g_name_cache;
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<QualifiedNameCache>,
+                                  name_caches, ());
+  if (IsInitializingThread()) {
+    if (nullptr == g_initial_name_cache)
+      g_initial_name_cache = new QualifiedNameCache;
+    return *g_initial_name_cache;
+  }
+
+  QualifiedNameCache& name_cache = *name_caches;
+  if (name_cache.IsEmpty() && nullptr != g_initial_name_cache) {
+    for (QualifiedName::QualifiedNameImpl* name : *g_initial_name_cache) {
+      if (name->is_static_)
+        name_cache.insert(name);
+    }
+  }
+  return name_cache;
+}
+
+// Static names are shared by all the engine threads, so their uppercased local
+// names are made static up front, instead of being cached on first use.
+static AtomicString StaticLocalNameUpper(const AtomicString& local_name) {
+  if (local_name.IsEmpty())
+    return AtomicString();
+
+  String upper = local_name.GetString().UpperASCII();
+  if (upper.Impl() == local_name.Impl())
+    return local_name;
+  if (!upper.Is8Bit())
+    return AtomicString();
+
+  const LChar* chars = upper.Characters8();
+  const unsigned length = upper.length();
+  const unsigned hash = StringHasher::ComputeHashAndMaskTop8Bits(chars, length);
+  return AtomicString(StringImpl::CreateStatic(
+      reinterpret_cast<const char*>(chars), length, hash));
 }
 
 struct QNameComponentsTranslator {
@@ -83,6 +121,8 @@ struct QNameComponentsTranslator {
     auto name = QualifiedName::QualifiedNameImpl::Create(
         AtomicString(components.prefix_), AtomicString(components.local_name_),
         AtomicString(components.namespace_), data.is_static_);
+    if (data.is_static_)
+      name->local_name_upper_ = StaticLocalNameUpper(name->local_name_);
     name->AddRef();
     location = name.get();
   }
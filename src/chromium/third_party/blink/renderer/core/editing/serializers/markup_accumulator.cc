@@ -242,6 +242,8 @@ String SerializeNodes(MarkupAccumulator& accumulator,
                       EChildrenOnly children_only) {
   bool success = accumulator.SerializeAsHTMLDocument(target_node);
   ASSERT(success);
+  SerializeNodesWithNamespaces<Strategy>(accumulator, target_node,
+                                         children_only, nullptr);
   return accumulator.ToString();
 }
 
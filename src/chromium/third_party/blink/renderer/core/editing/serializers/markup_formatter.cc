@@ -96,14 +96,14 @@ void MarkupFormatter::AppendCharactersReplacingEntities(
     unsigned offset,
     unsigned length,
     EntityMask entity_mask) {
-  DEFINE_STATIC_LOCAL(const CString, amp_reference, ("&amp;"));
-  DEFINE_STATIC_LOCAL(const CString, lt_reference, ("&lt;"));
-  DEFINE_STATIC_LOCAL(const CString, gt_reference, ("&gt;"));
-  DEFINE_STATIC_LOCAL(const CString, quot_reference, ("&quot;"));
-  DEFINE_STATIC_LOCAL(const CString, nbsp_reference, ("&nbsp;"));
-  DEFINE_STATIC_LOCAL(const CString, tab_reference, ("&#9;"));
-  DEFINE_STATIC_LOCAL(const CString, line_feed_reference, ("&#10;"));
-  DEFINE_STATIC_LOCAL(const CString, carriage_return_reference, ("&#13;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, amp_reference, ("&amp;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, lt_reference, ("&lt;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, gt_reference, ("&gt;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, quot_reference, ("&quot;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, nbsp_reference, ("&nbsp;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, tab_reference, ("&#9;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, line_feed_reference, ("&#10;"));
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(const CString, carriage_return_reference, ("&#13;"));
 
   static const EntityDescription kEntityMaps[] = {
       {'&', amp_reference, kEntityAmp},
@@ -44,11 +44,20 @@
 #include "third_party/blink/renderer/core/dom/document_fragment.h"
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/core/editing/serializers/markup_accumulator.h"
+#include "third_party/blink/renderer/core/editing/serializers/utf8_markup_writer.h"
 
 using namespace BlinKit;
 
 namespace blink {
 
+void AppendMarkupUTF8(std::string &dst, const Node &node, EChildrenOnly childrenOnly)
+{
+    UTF8MarkupWriter::Sink sink = [&dst](const char *data, size_t length) {
+        dst.append(data, length);
+    };
+    UTF8MarkupWriter(sink).Serialize(node, childrenOnly);
+}
+
 DocumentFragment* CreateFragmentForInnerOuterHTML(
     const String &markup,
     Element *contextElement,
@@ -39,6 +39,7 @@
 
 #pragma once
 
+#include <string>
 #include "third_party/blink/renderer/core/dom/parser_content_policy.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 
@@ -67,6 +68,8 @@ DocumentFragment* CreateFragmentForInnerOuterHTML(
 void ReplaceChildrenWithFragment(ContainerNode *container, DocumentFragment *fragment, ExceptionState &exceptionState);
 
 String CreateMarkup(const Node *node, EChildrenOnly childrenOnly = kIncludeNode, EAbsoluteURLs shouldResolveUrls = kDoNotResolveURLs);
+// Same as CreateMarkup, but appends UTF-8 to |dst| without an UTF-16 intermediate.
+void AppendMarkupUTF8(std::string &dst, const Node &node, EChildrenOnly childrenOnly = kIncludeNode);
 
 } // namespace blink
 
@@ -0,0 +1,406 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: utf8_markup_writer.cpp
+// Description: UTF8MarkupWriter Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "utf8_markup_writer.h"
+
+#include "third_party/blink/renderer/core/dom/attr.h"
+#include "third_party/blink/renderer/core/dom/cdata_section.h"
+#include "third_party/blink/renderer/core/dom/comment.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/document_type.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/dom/processing_instruction.h"
+#include "third_party/blink/renderer/core/editing/editing_utilities.h"
+#include "third_party/blink/renderer/core/html_element_type_helpers.h"
+#include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/core/xlink_names.h"
+#include "third_party/blink/renderer/core/xml_names.h"
+#include "third_party/blink/renderer/core/xmlns_names.h"
+#include "third_party/blink/renderer/platform/wtf/text/character_names.h"
+#ifndef BLINKIT_CRAWLER_ONLY
+#   include "third_party/blink/renderer/core/html/html_template_element.h"
+#endif
+
+namespace blink {
+
+// Entity bits of the ASCII characters which may need escaping, everything
+// else below 0x80 is copied as is.
+static const uint8_t kAsciiEntities[128] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, kEntityTab, kEntityLineFeed, 0, 0, kEntityCarriageReturn, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, kEntityQuot, 0, 0, 0, kEntityAmp, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, kEntityLt, 0, kEntityGt, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+template <typename CharType>
+static inline bool IsPlainASCII(CharType ch, EntityMask entityMask)
+{
+    return ch < 0x80 && 0 == (kAsciiEntities[ch] & entityMask);
+}
+
+UTF8MarkupWriter::UTF8MarkupWriter(const Sink &sink) : m_sink(sink), m_formatter(kDoNotResolveURLs), m_chunk(new char[kChunkSize])
+{
+}
+
+UTF8MarkupWriter::~UTF8MarkupWriter(void)
+{
+    Flush();
+}
+
+void UTF8MarkupWriter::Flush(void)
+{
+    if (0 == m_used)
+        return;
+    m_sink(m_chunk.get(), m_used);
+    m_used = 0;
+}
+
+void UTF8MarkupWriter::Serialize(const Node &node, EChildrenOnly childrenOnly)
+{
+    if (m_formatter.SerializeAsHTMLDocument(node))
+    {
+        SerializeNode(node, childrenOnly);
+        return;
+    }
+
+    // XML serialization needs the namespace bookkeeping of MarkupAccumulator,
+    // which is rare enough for a crawler to go through the UTF-16 path.
+    Write(CreateMarkup(&node, childrenOnly));
+}
+
+void UTF8MarkupWriter::SerializeNode(const Node &node, EChildrenOnly childrenOnly)
+{
+    if (kIncludeNode == childrenOnly)
+        WriteStartMarkup(node);
+
+    if (ElementCannotHaveEndTag(node))
+        return;
+
+#ifdef BLINKIT_CRAWLER_ONLY
+    // There is no template content in crawlers, the parser keeps the contents of a template as its children, which
+    // MarkupAccumulator serializes as well.
+    const Node *child = node.firstChild();
+#else
+    const Node *child = IsHTMLTemplateElement(node)
+        ? ToHTMLTemplateElement(node).content()->firstChild()
+        : node.firstChild();
+#endif
+    for (; nullptr != child; child = child->nextSibling())
+        SerializeNode(*child, kIncludeNode);
+
+    if (kIncludeNode == childrenOnly && node.IsElementNode())
+        WriteElementEnd(ToElement(node));
+}
+
+void UTF8MarkupWriter::Write(const char *data, size_t length)
+{
+    if (kChunkSize - m_used < length)
+    {
+        Flush();
+        if (length >= kChunkSize)
+        {
+            m_sink(data, length);
+            return;
+        }
+    }
+    memcpy(m_chunk.get() + m_used, data, length);
+    m_used += length;
+}
+
+void UTF8MarkupWriter::Write(const String &s, EntityMask entityMask)
+{
+    if (s.IsEmpty())
+        return;
+    if (s.Is8Bit())
+        WriteCharacters(s.Characters8(), s.length(), entityMask);
+    else
+        WriteCharacters(s.Characters16(), s.length(), entityMask);
+}
+
+void UTF8MarkupWriter::WriteAttribute(const Element &element, const Attribute &attribute)
+{
+    QualifiedName prefixedName = attribute.GetName();
+    if (attribute.NamespaceURI() == xmlns_names::kNamespaceURI)
+    {
+        if (!attribute.Prefix() && attribute.LocalName() != g_xmlns_atom)
+            prefixedName.SetPrefix(g_xmlns_atom);
+    }
+    else if (attribute.NamespaceURI() == xml_names::kNamespaceURI)
+    {
+        prefixedName.SetPrefix(g_xml_atom);
+    }
+    else if (attribute.NamespaceURI() == xlink_names::kNamespaceURI)
+    {
+        prefixedName.SetPrefix(g_xlink_atom);
+    }
+
+    Write(' ');
+    WriteQualifiedName(prefixedName);
+    Write('=');
+
+    const AtomicString &value = attribute.Value();
+    if (!element.IsURLAttribute(attribute))
+    {
+        Write('"');
+        Write(value, kEntityMaskInHTMLAttributeValue);
+        Write('"');
+        return;
+    }
+
+    // Same as MarkupFormatter::AppendQuotedURLAttributeValue.
+    if (value.StartsWith("javascript:"))
+    {
+        char quote = '"';
+        int entityMask = kEntityAmp;
+        if (value.Contains('"'))
+        {
+            if (value.Contains('\''))
+                entityMask |= kEntityQuot;
+            else
+                quote = '\'';
+        }
+        Write(quote);
+        Write(value, static_cast<EntityMask>(entityMask));
+        Write(quote);
+        return;
+    }
+
+    Write('"');
+    Write(value, kEntityMaskInAttributeValue);
+    Write('"');
+}
+
+template <typename CharType>
+void UTF8MarkupWriter::WriteCharacters(const CharType *s, unsigned length, EntityMask entityMask)
+{
+    unsigned i = 0;
+    while (i < length)
+    {
+        unsigned start = i;
+        while (i < length && IsPlainASCII(s[i], entityMask))
+            ++i;
+
+        if (start < i)
+        {
+            if (sizeof(CharType) == sizeof(char))
+            {
+                Write(reinterpret_cast<const char *>(s + start), i - start);
+            }
+            else
+            {
+                for (unsigned j = start; j < i; ++j)
+                    Write(static_cast<char>(s[j]));
+            }
+        }
+
+        if (i == length)
+            break;
+
+        UChar32 ch = s[i++];
+        if (WriteEntity(ch, entityMask))
+            continue;
+
+        if (U16_IS_LEAD(ch) && i < length && U16_IS_TRAIL(s[i]))
+            ch = U16_GET_SUPPLEMENTARY(ch, s[i++]);
+        else if (U16_IS_SURROGATE(ch))
+            ch = kReplacementCharacter;
+        WriteCodePoint(ch);
+    }
+}
+
+void UTF8MarkupWriter::WriteCodePoint(UChar32 ch)
+{
+    if (kChunkSize - m_used < 4)
+        Flush();
+
+    char *p = m_chunk.get() + m_used;
+    if (ch < 0x80)
+    {
+        p[0] = static_cast<char>(ch);
+        m_used += 1;
+    }
+    else if (ch < 0x800)
+    {
+        p[0] = static_cast<char>(0xc0 | (ch >> 6));
+        p[1] = static_cast<char>(0x80 | (ch & 0x3f));
+        m_used += 2;
+    }
+    else if (ch < 0x10000)
+    {
+        p[0] = static_cast<char>(0xe0 | (ch >> 12));
+        p[1] = static_cast<char>(0x80 | ((ch >> 6) & 0x3f));
+        p[2] = static_cast<char>(0x80 | (ch & 0x3f));
+        m_used += 3;
+    }
+    else
+    {
+        p[0] = static_cast<char>(0xf0 | (ch >> 18));
+        p[1] = static_cast<char>(0x80 | ((ch >> 12) & 0x3f));
+        p[2] = static_cast<char>(0x80 | ((ch >> 6) & 0x3f));
+        p[3] = static_cast<char>(0x80 | (ch & 0x3f));
+        m_used += 4;
+    }
+}
+
+void UTF8MarkupWriter::WriteDocumentType(const DocumentType &documentType)
+{
+    if (documentType.name().IsEmpty())
+        return;
+
+    WriteLiteral("<!DOCTYPE ");
+    Write(documentType.name());
+    if (!documentType.publicId().IsEmpty())
+    {
+        WriteLiteral(" PUBLIC \"");
+        Write(documentType.publicId());
+        Write('"');
+        if (!documentType.systemId().IsEmpty())
+        {
+            WriteLiteral(" \"");
+            Write(documentType.systemId());
+            Write('"');
+        }
+    }
+    else if (!documentType.systemId().IsEmpty())
+    {
+        WriteLiteral(" SYSTEM \"");
+        Write(documentType.systemId());
+        Write('"');
+    }
+    Write('>');
+}
+
+void UTF8MarkupWriter::WriteElementEnd(const Element &element)
+{
+    WriteLiteral("</");
+    WriteQualifiedName(element.TagQName());
+    Write('>');
+}
+
+void UTF8MarkupWriter::WriteElementStart(const Element &element)
+{
+    Write('<');
+    WriteQualifiedName(element.TagQName());
+
+    AttributeCollection attributes = element.Attributes();
+    const AtomicString &isValue = element.IsValue();
+    if (!isValue.IsNull() && !attributes.Find(html_names::kIsAttr))
+        WriteAttribute(element, Attribute(html_names::kIsAttr, isValue));
+    for (const Attribute &attribute : attributes)
+        WriteAttribute(element, attribute);
+
+    Write('>');
+}
+
+bool UTF8MarkupWriter::WriteEntity(UChar ch, EntityMask entityMask)
+{
+    switch (ch)
+    {
+        case '&':
+            if (0 == (entityMask & kEntityAmp))
+                return false;
+            WriteLiteral("&amp;");
+            break;
+        case '<':
+            if (0 == (entityMask & kEntityLt))
+                return false;
+            WriteLiteral("&lt;");
+            break;
+        case '>':
+            if (0 == (entityMask & kEntityGt))
+                return false;
+            WriteLiteral("&gt;");
+            break;
+        case '"':
+            if (0 == (entityMask & kEntityQuot))
+                return false;
+            WriteLiteral("&quot;");
+            break;
+        case kNoBreakSpaceCharacter:
+            if (0 == (entityMask & kEntityNbsp))
+                return false;
+            WriteLiteral("&nbsp;");
+            break;
+        case '\t':
+            if (0 == (entityMask & kEntityTab))
+                return false;
+            WriteLiteral("&#9;");
+            break;
+        case '\n':
+            if (0 == (entityMask & kEntityLineFeed))
+                return false;
+            WriteLiteral("&#10;");
+            break;
+        case '\r':
+            if (0 == (entityMask & kEntityCarriageReturn))
+                return false;
+            WriteLiteral("&#13;");
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void UTF8MarkupWriter::WriteQualifiedName(const QualifiedName &name)
+{
+    if (name.HasPrefix())
+    {
+        Write(name.Prefix());
+        Write(':');
+    }
+    Write(name.LocalName());
+}
+
+void UTF8MarkupWriter::WriteStartMarkup(const Node &node)
+{
+    switch (node.getNodeType())
+    {
+        case Node::kElementNode:
+            WriteElementStart(ToElement(node));
+            break;
+        case Node::kTextNode:
+            Write(ToText(node).data(), m_formatter.EntityMaskForText(ToText(node)));
+            break;
+        case Node::kCommentNode:
+            WriteLiteral("<!--");
+            Write(ToComment(node).data());
+            WriteLiteral("-->");
+            break;
+        case Node::kDocumentTypeNode:
+            WriteDocumentType(ToDocumentType(node));
+            break;
+        case Node::kProcessingInstructionNode:
+            WriteLiteral("<?");
+            Write(ToProcessingInstruction(node).target());
+            Write(' ');
+            Write(ToProcessingInstruction(node).data());
+            WriteLiteral("?>");
+            break;
+        case Node::kCdataSectionNode:
+            WriteLiteral("<![CDATA[");
+            Write(ToCDATASection(node).data());
+            WriteLiteral("]]>");
+            break;
+        case Node::kAttributeNode:
+            Write(ToAttr(node).value(), kEntityMaskInHTMLAttributeValue);
+            break;
+        case Node::kDocumentNode:
+        case Node::kDocumentFragmentNode:
+            break;
+    }
+}
+
+} // namespace blink
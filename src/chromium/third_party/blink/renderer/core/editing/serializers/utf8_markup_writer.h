@@ -0,0 +1,80 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: utf8_markup_writer.h
+// Description: UTF8MarkupWriter Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINK_UTF8_MARKUP_WRITER_H
+#define BLINKIT_BLINK_UTF8_MARKUP_WRITER_H
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include "third_party/blink/renderer/core/dom/qualified_name.h"
+#include "third_party/blink/renderer/core/editing/serializers/markup_formatter.h"
+#include "third_party/blink/renderer/platform/wtf/text/atomic_string_hash.h"
+
+namespace blink {
+
+class Attribute;
+class DocumentType;
+class Element;
+class Node;
+
+// Serializes a node tree as HTML, producing UTF-8 directly without building
+// an intermediate WTF::String. The output is collected in a fixed size chunk
+// and handed to the sink whenever the chunk is full, and once more on Flush.
+class UTF8MarkupWriter
+{
+    STACK_ALLOCATED();
+public:
+    using Sink = std::function<void(const char *, size_t)>;
+
+    explicit UTF8MarkupWriter(const Sink &sink);
+    ~UTF8MarkupWriter(void);
+
+    void Serialize(const Node &node, EChildrenOnly childrenOnly = kIncludeNode);
+    void Flush(void);
+private:
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    void SerializeNode(const Node &node, EChildrenOnly childrenOnly);
+    void WriteStartMarkup(const Node &node);
+    void WriteElementStart(const Element &element);
+    void WriteElementEnd(const Element &element);
+    void WriteAttribute(const Element &element, const Attribute &attribute);
+    void WriteDocumentType(const DocumentType &documentType);
+    void WriteQualifiedName(const QualifiedName &name);
+
+    void Write(char ch)
+    {
+        if (m_used == kChunkSize)
+            Flush();
+        m_chunk[m_used++] = ch;
+    }
+    void Write(const char *data, size_t length);
+    template <size_t N>
+    void WriteLiteral(const char (&s)[N]) { Write(s, N - 1); }
+    void Write(const String &s, EntityMask entityMask = kEntityMaskInCDATA);
+    template <typename CharType>
+    void WriteCharacters(const CharType *s, unsigned length, EntityMask entityMask);
+    void WriteCodePoint(UChar32 ch);
+    bool WriteEntity(UChar ch, EntityMask entityMask);
+
+    const Sink &m_sink;
+    MarkupFormatter m_formatter;
+    std::unique_ptr<char[]> m_chunk;
+    size_t m_used = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(UTF8MarkupWriter);
+};
+
+} // namespace blink
+
+#endif // BLINKIT_BLINK_UTF8_MARKUP_WRITER_H
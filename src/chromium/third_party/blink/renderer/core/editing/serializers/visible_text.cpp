@@ -0,0 +1,257 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: visible_text.cpp
+// Description: Visible Text Extraction
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#include "visible_text.h"
+
+#include <unicode/utf16.h>
+#include <unicode/utf8.h>
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/core/dom/node_traversal.h"
+#include "third_party/blink/renderer/core/dom/text.h"
+#include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
+#include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/platform/wtf/text/character_names.h"
+
+namespace blink {
+
+using namespace html_names;
+
+namespace {
+
+enum ElementFlags {
+    kSkipped      = 0x01,
+    kBlock        = 0x02,
+    kCell         = 0x04,
+    kLineBreak    = 0x08,
+    kPreformatted = 0x10
+};
+
+unsigned GetElementFlags(const Element &element)
+{
+    if (!element.IsHTMLElement())
+        return 0;
+
+    static const struct {
+        const HTMLQualifiedName &tag;
+        unsigned flags;
+    } kTags[] = {
+        { kHeadTag,       kSkipped },
+        { kScriptTag,     kSkipped },
+        { kStyleTag,      kSkipped },
+        { kTemplateTag,   kSkipped },
+        { kNoscriptTag,   kSkipped },
+        { kNoembedTag,    kSkipped },
+        { kNoframesTag,   kSkipped },
+        { kIFrameTag,     kSkipped },
+        { kObjectTag,     kSkipped },
+        { kAppletTag,     kSkipped },
+        { kBrTag,         kLineBreak },
+        { kTdTag,         kCell },
+        { kThTag,         kCell },
+        { kPreTag,        kBlock | kPreformatted },
+        { kListingTag,    kBlock | kPreformatted },
+        { kPlaintextTag,  kBlock | kPreformatted },
+        { kXmpTag,        kBlock | kPreformatted },
+        { kTextareaTag,   kPreformatted },
+        { kAddressTag,    kBlock },
+        { kArticleTag,    kBlock },
+        { kAsideTag,      kBlock },
+        { kBlockquoteTag, kBlock },
+        { kBodyTag,       kBlock },
+        { kCaptionTag,    kBlock },
+        { kCenterTag,     kBlock },
+        { kDdTag,         kBlock },
+        { kDetailsTag,    kBlock },
+        { kDirTag,        kBlock },
+        { kDivTag,        kBlock },
+        { kDlTag,         kBlock },
+        { kDtTag,         kBlock },
+        { kFieldsetTag,   kBlock },
+        { kFigcaptionTag, kBlock },
+        { kFigureTag,     kBlock },
+        { kFooterTag,     kBlock },
+        { kFormTag,       kBlock },
+        { kH1Tag,         kBlock },
+        { kH2Tag,         kBlock },
+        { kH3Tag,         kBlock },
+        { kH4Tag,         kBlock },
+        { kH5Tag,         kBlock },
+        { kH6Tag,         kBlock },
+        { kHeaderTag,     kBlock },
+        { kHgroupTag,     kBlock },
+        { kHrTag,         kBlock },
+        { kHTMLTag,       kBlock },
+        { kLiTag,         kBlock },
+        { kMainTag,       kBlock },
+        { kMenuTag,       kBlock },
+        { kNavTag,        kBlock },
+        { kOlTag,         kBlock },
+        { kOptionTag,     kBlock },
+        { kPTag,          kBlock },
+        { kSectionTag,    kBlock },
+        { kSummaryTag,    kBlock },
+        { kTableTag,      kBlock },
+        { kTbodyTag,      kBlock },
+        { kTfootTag,      kBlock },
+        { kTheadTag,      kBlock },
+        { kTrTag,         kBlock },
+        { kUlTag,         kBlock }
+    };
+
+    const QualifiedName &tagName = element.TagQName();
+    for (const auto &it : kTags)
+    {
+        if (tagName == it.tag)
+            return it.flags;
+    }
+    return 0;
+}
+
+class VisibleTextWriter
+{
+public:
+    explicit VisibleTextWriter(std::string &dst) : m_dst(dst) {}
+
+    void Append(const Node &node);
+private:
+    enum class Separator { kNone, kSpace, kNewLine };
+    void RequestSeparator(Separator separator)
+    {
+        if (m_separator < separator)
+            m_separator = separator;
+    }
+
+    void AppendText(const String &text);
+    template <typename CharType>
+    void AppendText(const CharType *s, unsigned length);
+    template <typename CharType>
+    void WriteCharacters(const CharType *s, unsigned length);
+
+    std::string &m_dst;
+    Separator m_separator = Separator::kNone;
+    bool m_hasContent = false;
+    unsigned m_preformattedDepth = 0;
+};
+
+void VisibleTextWriter::Append(const Node &node)
+{
+    if (node.IsTextNode())
+    {
+        AppendText(ToText(node).data());
+        return;
+    }
+
+    if (!node.IsContainerNode())
+        return;
+
+    const unsigned flags = node.IsElementNode() ? GetElementFlags(ToElement(node)) : 0;
+    if (flags & kSkipped)
+        return;
+    if (flags & kLineBreak)
+    {
+        RequestSeparator(Separator::kNewLine);
+        return;
+    }
+
+    if (flags & kBlock)
+        RequestSeparator(Separator::kNewLine);
+    else if (flags & kCell)
+        RequestSeparator(Separator::kSpace);
+    if (flags & kPreformatted)
+        ++m_preformattedDepth;
+
+    for (const Node *child = NodeTraversal::FirstChild(node); nullptr != child; child = NodeTraversal::NextSibling(*child))
+        Append(*child);
+
+    if (flags & kPreformatted)
+        --m_preformattedDepth;
+    if (flags & kBlock)
+        RequestSeparator(Separator::kNewLine);
+    else if (flags & kCell)
+        RequestSeparator(Separator::kSpace);
+}
+
+void VisibleTextWriter::AppendText(const String &text)
+{
+    if (text.IsEmpty())
+        return;
+    if (text.Is8Bit())
+        AppendText(text.Characters8(), text.length());
+    else
+        AppendText(text.Characters16(), text.length());
+}
+
+template <typename CharType>
+void VisibleTextWriter::AppendText(const CharType *s, unsigned length)
+{
+    if (m_preformattedDepth > 0)
+    {
+        WriteCharacters(s, length);
+        return;
+    }
+
+    unsigned i = 0;
+    while (i < length)
+    {
+        if (IsHTMLSpace<CharType>(s[i]))
+        {
+            RequestSeparator(Separator::kSpace);
+            ++i;
+            continue;
+        }
+
+        unsigned start = i;
+        while (i < length && !IsHTMLSpace<CharType>(s[i]))
+            ++i;
+        WriteCharacters(s + start, i - start);
+    }
+}
+
+template <typename CharType>
+void VisibleTextWriter::WriteCharacters(const CharType *s, unsigned length)
+{
+    if (m_hasContent && Separator::kNone != m_separator)
+        m_dst.push_back(Separator::kSpace == m_separator ? ' ' : '\n');
+    m_separator = Separator::kNone;
+    m_hasContent = true;
+
+    unsigned i = 0;
+    while (i < length)
+    {
+        unsigned start = i;
+        while (i < length && s[i] < 0x80)
+            ++i;
+        if (start < i)
+            m_dst.append(s + start, s + i);
+        if (i == length)
+            break;
+
+        UChar32 ch = s[i++];
+        if (U16_IS_LEAD(ch) && i < length && U16_IS_TRAIL(s[i]))
+            ch = U16_GET_SUPPLEMENTARY(ch, s[i++]);
+        else if (U16_IS_SURROGATE(ch))
+            ch = kReplacementCharacter;
+
+        char buf[U8_MAX_LENGTH];
+        size_t n = 0;
+        U8_APPEND_UNSAFE(buf, n, ch);
+        m_dst.append(buf, n);
+    }
+}
+
+} // namespace
+
+void AppendVisibleTextUTF8(std::string &dst, const Node &root)
+{
+    VisibleTextWriter(dst).Append(root);
+}
+
+} // namespace blink
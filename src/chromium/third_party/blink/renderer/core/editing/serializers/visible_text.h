@@ -0,0 +1,36 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: visible_text.h
+// Description: Visible Text Extraction
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+#ifndef BLINKIT_BLINK_VISIBLE_TEXT_H
+#define BLINKIT_BLINK_VISIBLE_TEXT_H
+
+#pragma once
+
+#include <string>
+
+namespace blink {
+
+class Node;
+
+// Appends the human readable text under |root| to |dst| as UTF-8.
+// Without layout, this is an approximation of innerText:
+// - Contents of head, script, style, template and other non-content elements
+//   are skipped.
+// - Runs of white space are collapsed into one space, except in pre, textarea
+//   and the like.
+// - Block level elements and br start a new line, table cells are separated
+//   by spaces.
+// - Leading and trailing white space is trimmed.
+void AppendVisibleTextUTF8(std::string &dst, const Node &root);
+
+} // namespace blink
+
+#endif // BLINKIT_BLINK_VISIBLE_TEXT_H
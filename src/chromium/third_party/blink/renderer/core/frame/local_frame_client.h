@@ -76,6 +76,8 @@ public:
     virtual void DispatchDidFailProvisionalLoad(const ResourceError &error) = 0;
     virtual void DispatchDidFailLoad(const ResourceError &error) = 0;
     virtual void RunScriptsAtDocumentIdle(void) {}
+    // The whole document is parsed, deferred scripts are not run yet.
+    virtual void DispatchDidParseDocument(void) {}
     virtual void DispatchDidFinishDocumentLoad(void) = 0;
     virtual void DispatchDidHandleOnloadEvents(void) = 0;
     virtual void DispatchDidFinishLoad(void) = 0;
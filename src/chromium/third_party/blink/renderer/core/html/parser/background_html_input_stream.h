@@ -0,0 +1,110 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: background_html_input_stream.h
+// Description: BackgroundHTMLInputStream Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+/*
+ * Copyright (C) 2013 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_BACKGROUND_HTML_INPUT_STREAM_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_BACKGROUND_HTML_INPUT_STREAM_H_
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/platform/text/segmented_string.h"
+#include "third_party/blink/renderer/platform/wtf/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+typedef size_t HTMLInputCheckpoint;
+
+class BackgroundHTMLInputStream {
+  DISALLOW_NEW();
+
+ public:
+  BackgroundHTMLInputStream();
+
+  void Append(const String&);
+  void Close();
+
+  SegmentedString& Current() { return current_; }
+
+  // An HTMLInputCheckpoint is valid until the next call to RewindTo, at which
+  // point all outstanding checkpoints are invalidated.
+  HTMLInputCheckpoint CreateCheckpoint(
+      size_t tokens_extracted_since_previous_checkpoint);
+  void RewindTo(HTMLInputCheckpoint, const String& unparsed_input);
+  void InvalidateCheckpointsBefore(HTMLInputCheckpoint);
+
+  size_t TotalCheckpointTokenCount() const {
+    return total_checkpoint_token_count_;
+  }
+
+ private:
+  struct Checkpoint {
+    Checkpoint(const SegmentedString& i,
+               size_t n,
+               size_t t)
+        : input(i),
+          number_of_segments_already_appended(n),
+          tokens_extracted_since_previous_checkpoint(t) {}
+
+    SegmentedString input;
+    size_t number_of_segments_already_appended;
+    size_t tokens_extracted_since_previous_checkpoint;
+
+    bool IsNull() const {
+      return input.IsEmpty() && !number_of_segments_already_appended;
+    }
+    void Clear() {
+      input.Clear();
+      number_of_segments_already_appended = 0;
+      tokens_extracted_since_previous_checkpoint = 0;
+    }
+  };
+
+  SegmentedString current_;
+  Vector<String> segments_;
+  Vector<Checkpoint> checkpoints_;
+
+  // Note: These indices may === vector.size(), in which case there are no
+  // valid checkpoints/segments at this time.
+  size_t first_valid_checkpoint_index_;
+  size_t first_valid_segment_index_;
+  size_t total_checkpoint_token_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundHTMLInputStream);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_BACKGROUND_HTML_INPUT_STREAM_H_
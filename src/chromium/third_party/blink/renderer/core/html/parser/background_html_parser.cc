@@ -0,0 +1,311 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: background_html_parser.cc
+// Description: BackgroundHTMLParser Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+/*
+ * Copyright (C) 2013 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "third_party/blink/renderer/core/html/parser/background_html_parser.h"
+
+#include <utility>
+#include "base/single_thread_task_runner.h"
+#include "third_party/blink/renderer/core/html/parser/html_tokenizer.h"
+#include "third_party/blink/renderer/core/html/parser/input_stream_preprocessor.h"
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
+
+namespace blink {
+
+// On a network with high latency and high bandwidth, using a device with a
+// fast CPU, we could end up speculatively tokenizing the whole document, well
+// ahead of when the main-thread actually needs it. This is a waste of memory
+// (and potentially time if the speculation fails). So we limit our outstanding
+// tokens arbitrarily to 10,000. Our maximal memory spent speculating will be
+// approximately: (kDefaultOutstandingTokenLimit + kDefaultPendingTokenLimit) *
+// sizeof(CompactToken)
+//
+// We use a separate low and high water mark to avoid
+// constantly topping off the main thread's token buffer. At time of writing,
+// this is (10000 + 1000) * 28 bytes = ~308kb of memory. These numbers have not
+// been tuned.
+static const size_t kDefaultOutstandingTokenLimit = 10000;
+
+// We limit our chucks to 1000 tokens, to make sure the main thread is never
+// waiting on the parser thread for tokens. This was tuned in
+// https://bugs.webkit.org/show_bug.cgi?id=110408.
+static const size_t kDefaultPendingTokenLimit = 1000;
+
+bool TokenizedChunkQueue::Enqueue(ChunkPtr chunk) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  bool was_empty = pending_chunks_.IsEmpty();
+  pending_chunks_.push_back(std::move(chunk));
+  return was_empty;
+}
+
+void TokenizedChunkQueue::Clear() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_chunks_.clear();
+}
+
+void TokenizedChunkQueue::TakeAll(Vector<ChunkPtr>& chunks) {
+  DCHECK(chunks.IsEmpty());
+  std::unique_lock<std::mutex> lock(mutex_);
+  chunks.swap(pending_chunks_);
+}
+
+BackgroundHTMLParser::Configuration::Configuration()
+    : outstanding_token_limit(kDefaultOutstandingTokenLimit),
+      pending_token_limit(kDefaultPendingTokenLimit) {}
+
+BackgroundHTMLParser* BackgroundHTMLParser::Create(
+    std::unique_ptr<Configuration> config,
+    const MediaValuesCached::MediaValuesCachedData& media_values_cached_data) {
+  DCHECK(IsMainThread());
+  return new BackgroundHTMLParser(std::move(config), media_values_cached_data);
+}
+
+BackgroundHTMLParser::BackgroundHTMLParser(
+    std::unique_ptr<Configuration> config,
+    const MediaValuesCached::MediaValuesCachedData& media_values_cached_data)
+    : token_(std::make_unique<HTMLToken>()),
+      tokenizer_(HTMLTokenizer::Create(config->options)),
+      tree_builder_simulator_(config->options),
+      options_(config->options),
+      outstanding_token_limit_(config->outstanding_token_limit),
+      parser_(std::move(config->parser)),
+      generation_(0),
+      pending_token_limit_(config->pending_token_limit),
+      preload_scanner_(std::make_unique<TokenPreloadScanner>(
+          config->document_url,
+          std::move(config->document_parameters),
+          media_values_cached_data,
+          TokenPreloadScanner::ScannerType::kMainDocument)),
+      decoder_(std::move(config->decoder)),
+      loading_task_runner_(std::move(config->loading_task_runner)),
+      tokenized_chunk_queue_(std::move(config->tokenized_chunk_queue)),
+      pending_csp_meta_token_index_(
+          HTMLDocumentParser::TokenizedChunk::kNoPendingToken),
+      starting_script_(false) {
+  DCHECK_GT(outstanding_token_limit_, 0u);
+  DCHECK_GT(pending_token_limit_, 0u);
+  DCHECK_GE(outstanding_token_limit_, pending_token_limit_);
+  if (options_.for_crawler)
+    preload_scanner_->SetIsForCrawler();
+}
+
+BackgroundHTMLParser::~BackgroundHTMLParser() = default;
+
+void BackgroundHTMLParser::AppendRawBytesFromMainThread(
+    const std::string& bytes) {
+  DCHECK(decoder_);
+  UpdateDocument(decoder_->Decode(bytes.data(), bytes.length()));
+}
+
+void BackgroundHTMLParser::AppendDecodedBytes(const String& input) {
+  DCHECK(!input_.Current().IsClosed());
+  input_.Append(input);
+  PumpTokenizer();
+}
+
+void BackgroundHTMLParser::SetDecoder(
+    std::unique_ptr<TextResourceDecoder> decoder) {
+  DCHECK(decoder);
+  decoder_ = std::move(decoder);
+}
+
+void BackgroundHTMLParser::Flush() {
+  DCHECK(decoder_);
+  UpdateDocument(decoder_->Flush());
+}
+
+void BackgroundHTMLParser::UpdateDocument(const String& decoded_data) {
+  DocumentEncodingData encoding_data(*decoder_.get());
+  if (encoding_data != last_seen_encoding_data_) {
+    last_seen_encoding_data_ = encoding_data;
+    RunOnMainThread([encoding_data](HTMLDocumentParser* parser) {
+      parser->DidReceiveEncodingDataFromBackgroundParser(encoding_data);
+    });
+  }
+
+  if (decoded_data.IsEmpty())
+    return;
+
+  AppendDecodedBytes(decoded_data);
+}
+
+void BackgroundHTMLParser::ResumeFrom(std::unique_ptr<Checkpoint> checkpoint) {
+  generation_ = checkpoint->generation;
+  token_ = std::move(checkpoint->token);
+  tokenizer_ = std::move(checkpoint->tokenizer);
+  tree_builder_simulator_.SetState(checkpoint->tree_builder_state);
+  input_.RewindTo(checkpoint->input_checkpoint, checkpoint->unparsed_input);
+  preload_scanner_->RewindTo(checkpoint->preload_scanner_checkpoint);
+  pending_tokens_.clear();
+  pending_preloads_.clear();
+  pending_csp_meta_token_index_ =
+      HTMLDocumentParser::TokenizedChunk::kNoPendingToken;
+  starting_script_ = false;
+  tokenized_chunk_queue_->Clear();
+  PumpTokenizer();
+}
+
+void BackgroundHTMLParser::StartedChunkWithCheckpoint(
+    HTMLInputCheckpoint input_checkpoint) {
+  // Note, we should not have to worry about the index being invalid as messages
+  // from the main thread will be processed in FIFO order.
+  input_.InvalidateCheckpointsBefore(input_checkpoint);
+  PumpTokenizer();
+}
+
+void BackgroundHTMLParser::Finish() {
+  MarkEndOfFile();
+  PumpTokenizer();
+}
+
+void BackgroundHTMLParser::Stop() {
+  delete this;
+}
+
+void BackgroundHTMLParser::MarkEndOfFile() {
+  DCHECK(!input_.Current().IsClosed());
+  input_.Append(String(&kEndOfFileMarker, 1));
+  input_.Close();
+}
+
+void BackgroundHTMLParser::PumpTokenizer() {
+  HTMLTreeBuilderSimulator::SimulatedToken simulated_token =
+      HTMLTreeBuilderSimulator::kOtherToken;
+
+  // No need to start speculating until the main thread has almost caught up.
+  if (input_.TotalCheckpointTokenCount() > outstanding_token_limit_)
+    return;
+
+  bool should_notify_main_thread = false;
+  while (true) {
+    if (!tokenizer_->NextToken(input_.Current(), *token_)) {
+      // We've reached the end of our current input.
+      should_notify_main_thread |= QueueChunkForMainThread();
+      break;
+    }
+
+    {
+      TextPosition position = TextPosition(input_.Current().CurrentLine(),
+                                           input_.Current().CurrentColumn());
+
+      CompactHTMLToken token(token_.get(), position);
+
+      bool is_csp_meta_tag = false;
+#ifdef BLINKIT_CRAWLER_ONLY
+      ViewportDescriptionWrapper* viewport_description = nullptr;
+#else
+      ViewportDescriptionWrapper* viewport_description = &viewport_description_;
+#endif
+      preload_scanner_->Scan(token, input_.Current(), pending_preloads_,
+                             viewport_description, &is_csp_meta_tag);
+
+      simulated_token =
+          tree_builder_simulator_.Simulate(token, tokenizer_.get());
+
+      // Break chunks before a script tag is inserted and flag the chunk as
+      // starting a script so the main parser can decide if it should yield
+      // before processing the chunk.
+      if (simulated_token == HTMLTreeBuilderSimulator::kValidScriptStart) {
+        should_notify_main_thread |= QueueChunkForMainThread();
+        starting_script_ = true;
+      }
+
+      pending_tokens_.push_back(token);
+      if (is_csp_meta_tag)
+        pending_csp_meta_token_index_ = pending_tokens_.size() - 1;
+    }
+
+    token_->Clear();
+
+    if (simulated_token == HTMLTreeBuilderSimulator::kScriptEnd ||
+        simulated_token == HTMLTreeBuilderSimulator::kStyleEnd ||
+        simulated_token == HTMLTreeBuilderSimulator::kLink ||
+        pending_tokens_.size() >= pending_token_limit_) {
+      should_notify_main_thread |= QueueChunkForMainThread();
+
+      // If we're far ahead of the main thread, yield for a bit to avoid
+      // consuming too much memory.
+      if (input_.TotalCheckpointTokenCount() > outstanding_token_limit_)
+        break;
+    }
+  }
+
+  if (should_notify_main_thread)
+    NotifyMainThread();
+}
+
+bool BackgroundHTMLParser::QueueChunkForMainThread() {
+  if (pending_tokens_.IsEmpty())
+    return false;
+
+  std::unique_ptr<HTMLDocumentParser::TokenizedChunk> chunk =
+      std::make_unique<HTMLDocumentParser::TokenizedChunk>();
+  chunk->preloads.swap(pending_preloads_);
+#ifndef BLINKIT_CRAWLER_ONLY
+  if (viewport_description_.set)
+    chunk->viewport = viewport_description_;
+#endif
+  chunk->tokenizer_state = tokenizer_->GetState();
+  chunk->tree_builder_state = tree_builder_simulator_.GetState();
+  chunk->input_checkpoint = input_.CreateCheckpoint(pending_tokens_.size());
+  chunk->preload_scanner_checkpoint = preload_scanner_->CreateCheckpoint();
+  chunk->tokens.swap(pending_tokens_);
+  chunk->starting_script = starting_script_;
+  chunk->pending_csp_meta_token_index = pending_csp_meta_token_index_;
+  starting_script_ = false;
+  pending_csp_meta_token_index_ =
+      HTMLDocumentParser::TokenizedChunk::kNoPendingToken;
+
+  return tokenized_chunk_queue_->Enqueue(std::move(chunk));
+}
+
+void BackgroundHTMLParser::NotifyMainThread() {
+  unsigned generation = generation_;
+  RunOnMainThread([generation](HTMLDocumentParser* parser) {
+    parser->NotifyPendingTokenizedChunks(generation);
+  });
+}
+
+void BackgroundHTMLParser::RunOnMainThread(
+    std::function<void(HTMLDocumentParser*)> task) {
+  std::weak_ptr<HTMLDocumentParser> parser = parser_;
+  std::function<void()> callback = [parser, task] {
+    if (std::shared_ptr<HTMLDocumentParser> p = parser.lock())
+      task(p.get());
+  };
+  loading_task_runner_->PostTask(FROM_HERE, callback);
+}
+
+}  // namespace blink
@@ -0,0 +1,181 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: background_html_parser.h
+// Description: BackgroundHTMLParser Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+/*
+ * Copyright (C) 2013 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_BACKGROUND_HTML_PARSER_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_BACKGROUND_HTML_PARSER_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "base/macros.h"
+#include "third_party/blink/renderer/core/dom/document_encoding_data.h"
+#include "third_party/blink/renderer/core/html/parser/background_html_input_stream.h"
+#include "third_party/blink/renderer/core/html/parser/compact_html_token.h"
+#include "third_party/blink/renderer/core/html/parser/html_document_parser.h"
+#include "third_party/blink/renderer/core/html/parser/html_preload_scanner.h"
+#include "third_party/blink/renderer/core/html/parser/html_tree_builder_simulator.h"
+#include "third_party/blink/renderer/core/html/parser/text_resource_decoder.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}
+
+namespace blink {
+
+class HTMLDocumentParser;
+
+// Chunks travel from the parser thread to the main thread through this queue.
+// The parser thread only notifies the main thread when the queue turns from
+// empty to non-empty.
+class TokenizedChunkQueue {
+  USING_FAST_MALLOC(TokenizedChunkQueue);
+
+ public:
+  typedef std::unique_ptr<HTMLDocumentParser::TokenizedChunk> ChunkPtr;
+
+  TokenizedChunkQueue() = default;
+
+  // Returns true if the queue was empty before |chunk| was added.
+  bool Enqueue(ChunkPtr chunk);
+  void Clear();
+  void TakeAll(Vector<ChunkPtr>& chunks);
+
+ private:
+  std::mutex mutex_;
+  Vector<ChunkPtr> pending_chunks_;
+
+  DISALLOW_COPY_AND_ASSIGN(TokenizedChunkQueue);
+};
+
+// Decodes, tokenizes and preload scans the document on the HTMLParserThread.
+// The parser deletes itself in Stop().
+class BackgroundHTMLParser {
+  USING_FAST_MALLOC(BackgroundHTMLParser);
+
+ public:
+  struct Configuration {
+    USING_FAST_MALLOC(Configuration);
+
+   public:
+    Configuration();
+
+    HTMLParserOptions options;
+    std::weak_ptr<HTMLDocumentParser> parser;
+    std::shared_ptr<base::SingleThreadTaskRunner> loading_task_runner;
+    std::shared_ptr<TokenizedChunkQueue> tokenized_chunk_queue;
+    std::unique_ptr<TextResourceDecoder> decoder;
+    BlinKit::BkURL document_url;
+    std::unique_ptr<CachedDocumentParameters> document_parameters;
+    // The parser stops tokenizing when the main thread has this many tokens
+    // to process, and resumes when the main thread catches up.
+    size_t outstanding_token_limit;
+    // The maximum number of tokens in a chunk.
+    size_t pending_token_limit;
+  };
+
+  // Called on the main thread. The returned parser must only be used on the
+  // parser thread from now on.
+  static BackgroundHTMLParser* Create(
+      std::unique_ptr<Configuration>,
+      const MediaValuesCached::MediaValuesCachedData&);
+
+  struct Checkpoint {
+    USING_FAST_MALLOC(Checkpoint);
+
+   public:
+    unsigned generation;
+    std::unique_ptr<HTMLToken> token;
+    std::unique_ptr<HTMLTokenizer> tokenizer;
+    HTMLTreeBuilderSimulator::State tree_builder_state;
+    HTMLInputCheckpoint input_checkpoint;
+    TokenPreloadScannerCheckpoint preload_scanner_checkpoint;
+    String unparsed_input;
+  };
+
+  void AppendRawBytesFromMainThread(const std::string& bytes);
+  void SetDecoder(std::unique_ptr<TextResourceDecoder>);
+  void Flush();
+  void ResumeFrom(std::unique_ptr<Checkpoint>);
+  void StartedChunkWithCheckpoint(HTMLInputCheckpoint);
+  void Finish();
+  void Stop();
+
+ private:
+  BackgroundHTMLParser(std::unique_ptr<Configuration>,
+                       const MediaValuesCached::MediaValuesCachedData&);
+  ~BackgroundHTMLParser();
+
+  void AppendDecodedBytes(const String&);
+  void MarkEndOfFile();
+  void PumpTokenizer();
+  void UpdateDocument(const String& decoded_data);
+
+  // Returns true if the main thread needs to be notified.
+  bool QueueChunkForMainThread();
+  void NotifyMainThread();
+  void RunOnMainThread(std::function<void(HTMLDocumentParser*)> task);
+
+  BackgroundHTMLInputStream input_;
+  std::unique_ptr<HTMLToken> token_;
+  std::unique_ptr<HTMLTokenizer> tokenizer_;
+  HTMLTreeBuilderSimulator tree_builder_simulator_;
+  HTMLParserOptions options_;
+  const size_t outstanding_token_limit_;
+  std::weak_ptr<HTMLDocumentParser> parser_;
+  // Bumped by the main thread every time it discards speculations, so stale
+  // notifications can be ignored there.
+  unsigned generation_;
+  CompactHTMLTokenStream pending_tokens_;
+  const size_t pending_token_limit_;
+  PreloadRequestStream pending_preloads_;
+#ifndef BLINKIT_CRAWLER_ONLY
+  ViewportDescriptionWrapper viewport_description_;
+#endif
+  std::unique_ptr<TokenPreloadScanner> preload_scanner_;
+  std::unique_ptr<TextResourceDecoder> decoder_;
+  DocumentEncodingData last_seen_encoding_data_;
+  std::shared_ptr<base::SingleThreadTaskRunner> loading_task_runner_;
+  std::shared_ptr<TokenizedChunkQueue> tokenized_chunk_queue_;
+  int pending_csp_meta_token_index_;
+  bool starting_script_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundHTMLParser);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_BACKGROUND_HTML_PARSER_H_
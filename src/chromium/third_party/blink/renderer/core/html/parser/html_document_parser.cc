@@ -41,17 +41,22 @@
 
 #include "base/auto_reset.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/renderer/core/dom/document_fragment.h"
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/html/parser/atomic_html_token.h"
+#include "third_party/blink/renderer/core/html/parser/background_html_parser.h"
+#include "third_party/blink/renderer/core/html/parser/html_parser_thread.h"
 #include "third_party/blink/renderer/core/html/parser/html_resource_preloader.h"
 #include "third_party/blink/renderer/core/html/parser/html_tree_builder.h"
 #include "third_party/blink/renderer/core/html/parser/nesting_level_incrementer.h"
 #include "third_party/blink/renderer/core/html_names.h"
 #include "third_party/blink/renderer/core/loader/document_loader.h"
+#include "third_party/blink/renderer/core/loader/frame_loader.h"
 #include "third_party/blink/renderer/core/loader/navigation_scheduler.h"
 #include "third_party/blink/renderer/core/script/html_parser_script_runner.h"
 // BKTODO: #include "third_party/blink/renderer/platform/cross_thread_functional.h"
@@ -80,6 +85,38 @@ public:
     PumpSession(unsigned &nestingLevel) : NestingLevelIncrementer(nestingLevel) {}
 };
 
+class SpeculationsPumpSession final : public NestingLevelIncrementer
+{
+    STACK_ALLOCATED();
+public:
+    SpeculationsPumpSession(unsigned &nestingLevel)
+        : NestingLevelIncrementer(nestingLevel), m_startTime(base::TimeTicks::Now())
+    {
+    }
+
+    base::TimeDelta ElapsedTime(void) const { return base::TimeTicks::Now() - m_startTime; }
+
+    void AddedElementTokens(size_t count) { m_processedElementTokens += count; }
+    size_t ProcessedElementTokens(void) const { return m_processedElementTokens; }
+private:
+    const base::TimeTicks m_startTime;
+    size_t m_processedElementTokens = 0;
+};
+
+// Documents usually arrive in one piece in BlinKit, so small ones are parsed
+// faster on the main thread than handed over to the HTMLParserThread.
+static const size_t kMinimumLengthForBackgroundParsing = 32 * 1024;
+
+static bool ShouldYieldPumpSession(const SpeculationsPumpSession &session, bool startingScript)
+{
+    // Give other tasks, such as resource loads, a chance to run.
+    if (session.ElapsedTime().InMilliseconds() > 500)
+        return true;
+    // Yield if a lot of DOM work has been done in this session and a script tag
+    // is about to be parsed.
+    return startingScript && session.ProcessedElementTokens() > 256;
+}
+
 // This is a direct transcription of step 4 from:
 // http://www.whatwg.org/specs/web-apps/current-work/multipage/the-end.html#fragment-case
 static HTMLTokenizer::State TokenizerStateForContextElement(
@@ -141,12 +178,16 @@ HTMLDocumentParser::HTMLDocumentParser(Document& document,
       loading_task_runner_(document.GetTaskRunner(TaskType::kNetworking)),
       preloader_(HTMLResourcePreloader::Create(document)),
       pending_csp_meta_token_(nullptr),
+      background_parser_(nullptr),
+      speculation_generation_(0),
+      have_background_parser_(false),
+      is_scheduled_for_unpause_(false),
+      did_receive_data_(false),
       end_was_delayed_(false),
       tasks_were_paused_(false),
       pump_session_nesting_level_(0),
       pump_speculations_session_nesting_level_(0),
       is_parsing_at_line_number_(false),
-      tried_loading_link_headers_(false),
       added_pending_stylesheet_in_body_(false),
       is_waiting_for_stylesheets_(false) {
   DCHECK(token_ && tokenizer_);
@@ -159,6 +200,8 @@ void HTMLDocumentParser::Dispose() {
 }
 
 void HTMLDocumentParser::Detach() {
+  if (have_background_parser_)
+    StopBackgroundParser();
   DocumentParser::Detach();
   if (script_runner_)
     script_runner_->Detach();
@@ -177,6 +220,8 @@ void HTMLDocumentParser::Detach() {
 
 void HTMLDocumentParser::StopParsing() {
   DocumentParser::StopParsing();
+  if (have_background_parser_)
+    StopBackgroundParser();
 }
 
 // This kicks off "Once the user agent stops parsing" as described by:
@@ -204,6 +249,13 @@ void HTMLDocumentParser::PrepareToStopParsing() {
   if (IsDetached())
     return;
 
+  if (script_runner_) {
+    if (LocalFrame* frame = GetDocument()->GetFrame())
+      frame->Loader().ParserFinished();
+    if (IsDetached())
+      return;
+  }
+
   AttemptToRunDeferredScriptsAndEnd();
 }
 
@@ -264,57 +316,42 @@ void HTMLDocumentParser::EnqueueTokenizedChunk(
   if (!IsParsing())
     return;
 
-  // ApplicationCache needs to be initialized before issuing preloads. We
-  // suspend preload until HTMLHTMLElement is inserted and ApplicationCache is
-  // initialized. Note: link rel preloads don't follow this policy per the spec.
-  // These directives should initiate a fetch as fast as possible.
-  if (!tried_loading_link_headers_ && GetDocument()->Loader()) {
-    ASSERT(false); // BKTODO:
-#if 0
-    // Note that on commit, the loader dispatched preloads for all the non-media
-    // links.
-    GetDocument()->Loader()->DispatchLinkHeaderPreloads(
-        &chunk->viewport, LinkLoader::kOnlyLoadMedia);
-    tried_loading_link_headers_ = true;
-#endif
-  }
-
   // Defer preloads if any of the chunks contains a <meta> csp tag.
   if (chunk->pending_csp_meta_token_index != TokenizedChunk::kNoPendingToken) {
     pending_csp_meta_token_ =
         &chunk->tokens.at(chunk->pending_csp_meta_token_index);
   }
 
-  ASSERT(false); // BKTODO:
-#if 0
-  if (pending_csp_meta_token_ || !GetDocument()->documentElement()) {
-    PreloadRequestStream link_rel_preloads;
-    for (auto& request : chunk->preloads) {
-      // Link rel preloads don't need to wait for AppCache but they
-      // should probably wait for CSP.
-      if (!pending_csp_meta_token_ && request->IsLinkRelPreload())
-        link_rel_preloads.push_back(std::move(request));
-      else
+  if (preloader_) {
+    if (pending_csp_meta_token_ || !GetDocument()->documentElement()) {
+      for (auto& request : chunk->preloads)
         queued_preloads_.push_back(std::move(request));
+    } else {
+      // We can safely assume that there are no queued preloads request after
+      // the document element is available, as we empty the queue immediately
+      // after the document element is created in DocumentElementAvailable().
+      DCHECK(queued_preloads_.empty());
+      preloader_->TakeAndPreload(chunk->preloads);
     }
-    preloader_->TakeAndPreload(link_rel_preloads);
-  } else {
-    // We can safely assume that there are no queued preloads request after the
-    // document element is available, as we empty the queue immediately after
-    // the document element is created in documentElementAvailable().
-    DCHECK(queued_preloads_.IsEmpty());
-    preloader_->TakeAndPreload(chunk->preloads);
   }
 
   speculations_.push_back(std::move(chunk));
 
-  if (!IsPaused() && !IsScheduledForUnpause()) {
-    if (tasks_were_paused_)
-      parser_scheduler_->ForceUnpauseAfterYield();
-    else
-      parser_scheduler_->ScheduleForUnpause();
-  }
-#endif
+  // Paused tasks are picked up again in UnpauseScheduledTasks().
+  if (!IsPaused() && !tasks_were_paused_)
+    ScheduleForUnpause();
+}
+
+void HTMLDocumentParser::NotifyPendingTokenizedChunks(unsigned generation) {
+  // Chunks of an older generation were cleared by the background parser when
+  // it rewound, and newer ones come with their own notification.
+  if (!have_background_parser_ || generation != speculation_generation_)
+    return;
+
+  Vector<std::unique_ptr<TokenizedChunk>> pending_chunks;
+  tokenized_chunk_queue_->TakeAll(pending_chunks);
+  for (auto& chunk : pending_chunks)
+    EnqueueTokenizedChunk(std::move(chunk));
 }
 
 void HTMLDocumentParser::DidReceiveEncodingDataFromBackgroundParser(
@@ -322,6 +359,215 @@ void HTMLDocumentParser::DidReceiveEncodingDataFromBackgroundParser(
   GetDocument()->SetEncodingData(data);
 }
 
+void HTMLDocumentParser::ValidateSpeculations(
+    std::unique_ptr<TokenizedChunk> chunk) {
+  DCHECK(chunk);
+  if (IsPaused()) {
+    // We're waiting on a network script or stylesheet, just save the chunk,
+    // we'll get a second ValidateSpeculations call after the script or
+    // stylesheet completes. This call should have been made immediately after
+    // RunScriptsForPausedTreeBuilder in the script case which may have started
+    // a network load and left us waiting.
+    DCHECK(!last_chunk_before_pause_);
+    last_chunk_before_pause_ = std::move(chunk);
+    return;
+  }
+
+  DCHECK(!last_chunk_before_pause_);
+  std::unique_ptr<HTMLTokenizer> tokenizer = std::move(tokenizer_);
+  std::unique_ptr<HTMLToken> token = std::move(token_);
+
+  if (!tokenizer) {
+    // There must not have been any changes to the HTMLTokenizer state on the
+    // main thread, which means the speculation buffer is correct.
+    return;
+  }
+
+  // Currently we're only smart enough to reuse the speculation buffer if the
+  // tokenizer both starts and ends in the DataState. That state is simplest
+  // because the HTMLToken is always in the Uninitialized state. We should
+  // consider whether we can reuse the speculation buffer in other states, but
+  // we'd likely need to do something more sophisticated with the HTMLToken.
+  if (chunk->tokenizer_state == HTMLTokenizer::kDataState &&
+      tokenizer->GetState() == HTMLTokenizer::kDataState &&
+      input_.Current().IsEmpty() &&
+      chunk->tree_builder_state ==
+          HTMLTreeBuilderSimulator::StateFor(tree_builder_.Get())) {
+    DCHECK(token->IsUninitialized());
+    return;
+  }
+
+  DiscardSpeculationsAndResumeFrom(std::move(chunk), std::move(token),
+                                   std::move(tokenizer));
+}
+
+void HTMLDocumentParser::DiscardSpeculationsAndResumeFrom(
+    std::unique_ptr<TokenizedChunk> last_chunk_before_script,
+    std::unique_ptr<HTMLToken> token,
+    std::unique_ptr<HTMLTokenizer> tokenizer) {
+  // Anything the background parser has queued up so far is stale.
+  ++speculation_generation_;
+  speculations_.clear();
+  pending_csp_meta_token_ = nullptr;
+  queued_preloads_.clear();
+
+  std::unique_ptr<BackgroundHTMLParser::Checkpoint> checkpoint =
+      std::make_unique<BackgroundHTMLParser::Checkpoint>();
+  checkpoint->generation = speculation_generation_;
+  checkpoint->token = std::move(token);
+  checkpoint->tokenizer = std::move(tokenizer);
+  checkpoint->tree_builder_state =
+      HTMLTreeBuilderSimulator::StateFor(tree_builder_.Get());
+  checkpoint->input_checkpoint = last_chunk_before_script->input_checkpoint;
+  checkpoint->preload_scanner_checkpoint =
+      last_chunk_before_script->preload_scanner_checkpoint;
+  checkpoint->unparsed_input = input_.Current().ToString().IsolatedCopy();
+  // FIXME: This should be passed in instead of cleared.
+  input_.Current().Clear();
+
+  DCHECK(checkpoint->unparsed_input.IsSafeToSendToAnotherThread());
+  auto shared_checkpoint =
+      std::make_shared<std::unique_ptr<BackgroundHTMLParser::Checkpoint>>(
+          std::move(checkpoint));
+  PostTaskToBackgroundParser(
+      [shared_checkpoint](BackgroundHTMLParser* background_parser) {
+        background_parser->ResumeFrom(std::move(*shared_checkpoint));
+      });
+}
+
+size_t HTMLDocumentParser::ProcessTokenizedChunkFromBackgroundParser(
+    std::unique_ptr<TokenizedChunk> chunk) {
+  DCHECK(!IsParsingFragment());
+  DCHECK(!IsPaused());
+  DCHECK(!IsStopped());
+  DCHECK(ShouldUseThreading());
+  DCHECK(!tokenizer_);
+  DCHECK(!token_);
+  DCHECK(!last_chunk_before_pause_);
+
+  const CompactHTMLTokenStream& tokens = chunk->tokens;
+  size_t element_token_count = 0;
+
+  HTMLInputCheckpoint input_checkpoint = chunk->input_checkpoint;
+  PostTaskToBackgroundParser(
+      [input_checkpoint](BackgroundHTMLParser* background_parser) {
+        background_parser->StartedChunkWithCheckpoint(input_checkpoint);
+      });
+
+  is_parsing_at_line_number_ = true;
+  for (const auto& token : tokens) {
+    DCHECK(!IsWaitingForScripts());
+
+    if (!chunk->starting_script &&
+        (token.GetType() == HTMLToken::kStartTag ||
+         token.GetType() == HTMLToken::kEndTag))
+      element_token_count++;
+
+    text_position_ = token.GetTextPosition();
+
+    ConstructTreeFromCompactHTMLToken(token);
+
+    if (IsStopped())
+      break;
+
+    // Preloads were queued if there was a <meta> csp token in a tokenized
+    // chunk.
+    if (pending_csp_meta_token_ && &token == pending_csp_meta_token_) {
+      pending_csp_meta_token_ = nullptr;
+      FetchQueuedPreloads();
+    }
+
+    if (IsPaused()) {
+      // The script or stylesheet should be the last token of this bunch.
+      DCHECK_EQ(&token, &tokens.back());
+      if (IsWaitingForScripts())
+        RunScriptsForPausedTreeBuilder();
+      ValidateSpeculations(std::move(chunk));
+      break;
+    }
+
+    if (token.GetType() == HTMLToken::kEndOfFile) {
+      // The EOF is assumed to be the last token of this bunch.
+      DCHECK_EQ(&token, &tokens.back());
+      // There should never be any chunks after the EOF.
+      DCHECK(speculations_.empty());
+      PrepareToStopParsing();
+      break;
+    }
+
+    DCHECK(!tokenizer_);
+    DCHECK(!token_);
+  }
+  is_parsing_at_line_number_ = false;
+
+  // Make sure all required pending text nodes are emitted before returning.
+  // This leaves "script", "style" and "svg" nodes text nodes intact.
+  if (!IsStopped())
+    tree_builder_->Flush(kFlushIfAtTextLimit);
+
+  return element_token_count;
+}
+
+void HTMLDocumentParser::PumpPendingSpeculations() {
+  // If this assert fails, you need to call ValidateSpeculations to make sure
+  // tokenizer_ and token_ don't have state that invalidates speculations_.
+  DCHECK(!tokenizer_);
+  DCHECK(!token_);
+  DCHECK(!last_chunk_before_pause_);
+  DCHECK(!IsPaused());
+  DCHECK(!IsStopped());
+  DCHECK(!IsExecutingScript());
+
+  // Do not allow pumping speculations in nested event loops.
+  if (pump_speculations_session_nesting_level_) {
+    ScheduleForUnpause();
+    return;
+  }
+
+  std::shared_ptr<HTMLDocumentParser> protect(shared_from_this());
+  SpeculationsPumpSession session(pump_speculations_session_nesting_level_);
+  while (!speculations_.empty()) {
+    if (!CanTakeNextToken())
+      break;
+
+    size_t element_token_count =
+        ProcessTokenizedChunkFromBackgroundParser(speculations_.TakeFirst());
+    session.AddedElementTokens(element_token_count);
+
+    CheckIfBodyStylesheetAdded();
+    if (!IsParsing() || IsPaused() || is_scheduled_for_unpause_)
+      break;
+
+    if (speculations_.empty())
+      break;
+    if (ShouldYieldPumpSession(session, speculations_.front()->starting_script)) {
+      ScheduleForUnpause();
+      break;
+    }
+  }
+}
+
+void HTMLDocumentParser::ScheduleForUnpause() {
+  if (is_scheduled_for_unpause_)
+    return;
+
+  is_scheduled_for_unpause_ = true;
+  std::weak_ptr<HTMLDocumentParser> parser = weak_from_this();
+  std::function<void()> callback = [parser] {
+    if (std::shared_ptr<HTMLDocumentParser> p = parser.lock())
+      p->ResumeAfterYield();
+  };
+  loading_task_runner_->PostTask(FROM_HERE, callback);
+}
+
+void HTMLDocumentParser::ResumeAfterYield() {
+  is_scheduled_for_unpause_ = false;
+  if (!IsParsing() || IsPaused() || tasks_were_paused_)
+    return;
+  if (!speculations_.empty())
+    PumpPendingSpeculations();
+}
+
 void HTMLDocumentParser::ForcePlaintextForTextDocument() {
   tokenizer_->SetState(HTMLTokenizer::kPLAINTEXTState);
 }
@@ -418,7 +664,7 @@ void HTMLDocumentParser::insert(const String& source) {
 
   if (!tokenizer_) {
     DCHECK(!InPumpSession());
-    DCHECK(WasCreatedByScript());
+    DCHECK(have_background_parser_ || WasCreatedByScript());
     token_ = std::make_unique<HTMLToken>();
     tokenizer_ = HTMLTokenizer::Create(options_);
   }
@@ -497,6 +743,9 @@ void HTMLDocumentParser::Append(const String& input_source) {
 void HTMLDocumentParser::end() {
   DCHECK(!IsDetached());
 
+  if (have_background_parser_)
+    StopBackgroundParser();
+
   std::shared_ptr<HTMLDocumentParser> protect(shared_from_this());
 
   // Informs the the rest of WebCore that parsing is really finished (and
@@ -553,6 +802,18 @@ void HTMLDocumentParser::Finish() {
   if (IsDetached())
     return;
 
+  // Empty documents never got an AppendBytes() call, and thus have never
+  // started a background parser. In those cases, we fall through to the
+  // non-threading case.
+  if (have_background_parser_) {
+    if (!input_.HaveSeenEndOfFile())
+      input_.CloseWithoutMarkingEndOfFile();
+    PostTaskToBackgroundParser([](BackgroundHTMLParser* background_parser) {
+      background_parser->Finish();
+    });
+    return;
+  }
+
   if (!tokenizer_) {
     DCHECK(!token_);
     // We're finishing before receiving any data. Rather than booting up the
@@ -582,10 +843,15 @@ bool HTMLDocumentParser::IsParsingAtLineNumber() const {
 }
 
 OrdinalNumber HTMLDocumentParser::LineNumber() const {
+  if (have_background_parser_)
+    return text_position_.line_;
   return input_.Current().CurrentLine();
 }
 
 TextPosition HTMLDocumentParser::GetTextPosition() const {
+  if (have_background_parser_)
+    return text_position_;
+
   const SegmentedString& current_string = input_.Current();
   OrdinalNumber line = current_string.CurrentLine();
   OrdinalNumber column = current_string.CurrentColumn();
@@ -624,6 +890,15 @@ void HTMLDocumentParser::ResumeParsingAfterPause() {
     return;
 
   insertion_preload_scanner_.reset();
+  if (have_background_parser_) {
+    if (last_chunk_before_pause_) {
+      ValidateSpeculations(std::move(last_chunk_before_pause_));
+      DCHECK(!last_chunk_before_pause_);
+      if (!IsPaused() && !IsStopped() && !speculations_.empty())
+        PumpPendingSpeculations();
+    }
+    return;
+  }
   if (tokenizer_) {
     PumpTokenizerIfPossible();
   }
@@ -718,12 +993,81 @@ void HTMLDocumentParser::PauseScheduledTasks() {
 void HTMLDocumentParser::UnpauseScheduledTasks() {
   DCHECK(tasks_were_paused_);
   tasks_were_paused_ = false;
+  // Speculations which arrived while tasks were paused have not been
+  // scheduled yet.
+  if (have_background_parser_ && !speculations_.empty() && !IsPaused())
+    ScheduleForUnpause();
+}
+
+void HTMLDocumentParser::StartBackgroundParser() {
+  DCHECK(!IsStopped());
+  DCHECK(ShouldUseThreading());
+  DCHECK(!have_background_parser_);
+  DCHECK(GetDocument());
+  have_background_parser_ = true;
+
+  // The tokenizer lives on the parser thread from now on. The main thread only
+  // creates a new one for document.write().
+  tokenizer_.reset();
+  token_.reset();
+
+  tokenized_chunk_queue_ = std::make_shared<TokenizedChunkQueue>();
+
+  std::unique_ptr<BackgroundHTMLParser::Configuration> config =
+      std::make_unique<BackgroundHTMLParser::Configuration>();
+  config->options = options_;
+  config->parser = weak_from_this();
+  config->loading_task_runner = loading_task_runner_;
+  config->tokenized_chunk_queue = tokenized_chunk_queue_;
+  config->decoder = TakeDecoder();
+  config->document_url = GetDocument()->Url();
+  config->document_parameters = CachedDocumentParameters::Create(GetDocument());
+
+  DCHECK(config->decoder);
+  background_parser_ = BackgroundHTMLParser::Create(
+      std::move(config),
+      MediaValuesCached::MediaValuesCachedData(*GetDocument()));
+}
+
+void HTMLDocumentParser::StopBackgroundParser() {
+  DCHECK(ShouldUseThreading());
+  DCHECK(have_background_parser_);
+
+  PostTaskToBackgroundParser([](BackgroundHTMLParser* background_parser) {
+    background_parser->Stop();
+  });
+  have_background_parser_ = false;
+  background_parser_ = nullptr;
+  ++speculation_generation_;
+}
+
+void HTMLDocumentParser::PostTaskToBackgroundParser(
+    std::function<void(BackgroundHTMLParser*)> task) {
+  DCHECK(have_background_parser_);
+  BackgroundHTMLParser* background_parser = background_parser_;
+  HTMLParserThread::Get().PostTask(
+      [background_parser, task] { task(background_parser); });
 }
 
 void HTMLDocumentParser::AppendBytes(const char* data, size_t length) {
   if (!length || IsStopped())
     return;
 
+  if (!did_receive_data_) {
+    did_receive_data_ = true;
+    if (ShouldUseThreading() && length >= kMinimumLengthForBackgroundParsing)
+      StartBackgroundParser();
+  }
+
+  if (have_background_parser_) {
+    std::string bytes(data, length);
+    PostTaskToBackgroundParser(
+        [bytes](BackgroundHTMLParser* background_parser) {
+          background_parser->AppendRawBytesFromMainThread(bytes);
+        });
+    return;
+  }
+
   DecodedDataDocumentParser::AppendBytes(data, length);
 }
 
@@ -732,6 +1076,13 @@ void HTMLDocumentParser::Flush() {
   if (IsDetached() || NeedsDecoder())
     return;
 
+  if (have_background_parser_) {
+    PostTaskToBackgroundParser([](BackgroundHTMLParser* background_parser) {
+      background_parser->Flush();
+    });
+    return;
+  }
+
   DecodedDataDocumentParser::Flush();
 }
 
@@ -739,6 +1090,15 @@ void HTMLDocumentParser::SetDecoder(
     std::unique_ptr<TextResourceDecoder> decoder) {
   DCHECK(decoder);
   DecodedDataDocumentParser::SetDecoder(std::move(decoder));
+
+  if (have_background_parser_) {
+    auto shared_decoder =
+        std::make_shared<std::unique_ptr<TextResourceDecoder>>(TakeDecoder());
+    PostTaskToBackgroundParser(
+        [shared_decoder](BackgroundHTMLParser* background_parser) {
+          background_parser->SetDecoder(std::move(*shared_decoder));
+        });
+  }
 }
 
 void HTMLDocumentParser::DocumentElementAvailable() {
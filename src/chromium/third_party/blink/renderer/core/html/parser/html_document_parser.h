@@ -37,10 +37,12 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
 
+#include <functional>
 #include <memory>
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/core/dom/parser_content_policy.h"
 #include "third_party/blink/renderer/core/dom/scriptable_document_parser.h"
+#include "third_party/blink/renderer/core/html/parser/background_html_input_stream.h"
 #include "third_party/blink/renderer/core/html/parser/html_input_stream.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_options.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_reentry_permit.h"
@@ -73,6 +75,7 @@ class HTMLParserScriptRunner;
 class HTMLPreloadScanner;
 class HTMLResourcePreloader;
 class HTMLTreeBuilder;
+class TokenizedChunkQueue;
 
 class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser
                                      , private HTMLParserScriptRunnerHost
@@ -123,6 +126,7 @@ class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser
 #endif
     HTMLTokenizer::State tokenizer_state;
     HTMLTreeBuilderSimulator::State tree_builder_state;
+    HTMLInputCheckpoint input_checkpoint;
     TokenPreloadScannerCheckpoint preload_scanner_checkpoint;
     bool starting_script;
     // Index into |tokens| of the last <meta> csp tag in |tokens|. Preloads will
@@ -134,6 +138,7 @@ class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser
   };
   void EnqueueTokenizedChunk(std::unique_ptr<TokenizedChunk>);
   void DidReceiveEncodingDataFromBackgroundParser(const DocumentEncodingData&);
+  void NotifyPendingTokenizedChunks(unsigned generation);
 
   void AppendBytes(const char* bytes, size_t length) override;
   void Flush() final;
@@ -185,6 +190,21 @@ class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser
   bool HasPreloadScanner() const final { return preload_scanner_.get(); }
   void AppendCurrentInputStreamToPreloadScannerAndScan() final;
 
+  void StartBackgroundParser();
+  void StopBackgroundParser();
+  void PostTaskToBackgroundParser(
+      std::function<void(BackgroundHTMLParser*)> task);
+  void ValidateSpeculations(std::unique_ptr<TokenizedChunk> last_chunk);
+  void DiscardSpeculationsAndResumeFrom(
+      std::unique_ptr<TokenizedChunk> last_chunk,
+      std::unique_ptr<HTMLToken>,
+      std::unique_ptr<HTMLTokenizer>);
+  size_t ProcessTokenizedChunkFromBackgroundParser(
+      std::unique_ptr<TokenizedChunk>);
+  void PumpPendingSpeculations();
+  void ScheduleForUnpause();
+  void ResumeAfterYield();
+
   bool CanTakeNextToken();
   void PumpTokenizer();
   void PumpTokenizerIfPossible();
@@ -200,6 +220,9 @@ class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser
   void end();
 
   bool IsParsingFragment() const;
+  bool ShouldUseThreading() const {
+    return options_.use_threading && !IsParsingFragment();
+  }
   bool InPumpSession() const { return pump_session_nesting_level_ > 0; }
   bool ShouldDelayEnd() const {
     return InPumpSession() || IsPaused() || IsExecutingScript();
@@ -250,12 +273,21 @@ class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser
 
   TaskHandle resume_parsing_task_handle_;
 
+  // Owned by the HTMLParserThread, and only touched by tasks posted there.
+  BackgroundHTMLParser* background_parser_;
+  std::shared_ptr<TokenizedChunkQueue> tokenized_chunk_queue_;
+  // Identifies the speculations the background parser is producing. Chunks
+  // notified for an older generation were tokenized before a rewind.
+  unsigned speculation_generation_;
+
+  bool have_background_parser_;
+  bool is_scheduled_for_unpause_;
+  bool did_receive_data_;
   bool end_was_delayed_;
   bool tasks_were_paused_;
   unsigned pump_session_nesting_level_;
   unsigned pump_speculations_session_nesting_level_;
   bool is_parsing_at_line_number_;
-  bool tried_loading_link_headers_;
   bool added_pending_stylesheet_in_body_;
   bool is_waiting_for_stylesheets_;
 };
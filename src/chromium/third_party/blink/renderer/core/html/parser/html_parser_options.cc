@@ -37,6 +37,7 @@
 #include "third_party/blink/renderer/core/html/parser/html_parser_options.h"
 
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 namespace blink {
 
@@ -46,6 +47,7 @@ HTMLParserOptions::HTMLParserOptions(Document* document) {
 
   if (LocalFrame* frame = document->GetFrame()) {
     script_enabled = document->CanExecuteScripts(kNotAboutToExecuteScript);
+    use_threading = RuntimeEnabledFeatures::ThreadedHTMLParserEnabled();
   }
   for_crawler = document->ForCrawler();
 }
@@ -50,6 +50,7 @@ class CORE_EXPORT HTMLParserOptions {
  public:
   bool script_enabled = false;
   bool for_crawler = true;
+  bool use_threading = false;
 
   explicit HTMLParserOptions(Document* = nullptr);
 };
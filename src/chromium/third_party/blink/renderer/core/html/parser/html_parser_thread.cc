@@ -0,0 +1,117 @@
+// -------------------------------------------------
+// BlinKit - blink Library
+// -------------------------------------------------
+//   File Name: html_parser_thread.cc
+// Description: HTMLParserThread Class
+//      Author: Ziming Li
+//     Created: 2026-10-18
+// -------------------------------------------------
+// Copyright (C) 2026 MingYang Software Technology.
+// -------------------------------------------------
+
+/*
+ * Copyright (C) 2013 Google, Inc. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "third_party/blink/renderer/core/html/parser/html_parser_thread.h"
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
+
+namespace blink {
+
+static std::atomic<HTMLParserThread*> g_parser_thread(nullptr);
+
+HTMLParserThread::HTMLParserThread() {
+  Start();
+}
+
+HTMLParserThread& HTMLParserThread::Get() {
+  DCHECK(IsMainThread());
+  static HTMLParserThread* thread = g_parser_thread = new HTMLParserThread;
+  return *thread;
+}
+
+void HTMLParserThread::PostTask(std::function<void()> task) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  tasks_.push_back(std::move(task));
+  condition_.notify_one();
+}
+
+void HTMLParserThread::PrepareForFork() {
+  HTMLParserThread* thread = g_parser_thread;
+  if (!thread)
+    return;
+
+  thread->fork_lock_ = std::unique_lock<std::mutex>(thread->mutex_);
+  thread->idle_condition_.wait(thread->fork_lock_,
+                               [thread] { return !thread->busy_; });
+}
+
+void HTMLParserThread::ResumeAfterFork(bool in_child) {
+  HTMLParserThread* thread = g_parser_thread;
+  if (!thread)
+    return;
+
+  if (!in_child) {
+    thread->fork_lock_.unlock();
+    return;
+  }
+
+  // Only the forking thread exists in the child, so the copies of the parent's
+  // primitives are renewed in place.
+  thread->fork_lock_.release();
+  new (&thread->mutex_) std::mutex;
+  new (&thread->condition_) std::condition_variable;
+  new (&thread->idle_condition_) std::condition_variable;
+  thread->Start();
+}
+
+void HTMLParserThread::Start() {
+  std::thread(ThreadProc, this).detach();
+}
+
+void HTMLParserThread::ThreadProc(HTMLParserThread* thread) {
+  thread->Run();
+}
+
+void HTMLParserThread::Run() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      busy_ = false;
+      idle_condition_.notify_all();
+      condition_.wait(lock, [this] { return !tasks_.empty(); });
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+      busy_ = true;
+    }
+    task();
+  }
+}
+
+}  // namespace blink
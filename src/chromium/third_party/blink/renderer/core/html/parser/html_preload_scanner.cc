@@ -46,7 +46,9 @@
 #include "third_party/blink/renderer/core/html/parser/html_tokenizer.h"
 #include "third_party/blink/renderer/core/html_names.h"
 #include "third_party/blink/renderer/core/script/script_loader.h"
+#include "third_party/blink/renderer/platform/loader/fetch/fetch_context.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
 #include "third_party/blink/renderer/platform/network/mime/content_type.h"
 #include "third_party/blink/renderer/platform/network/mime/mime_type_registry.h"
 #include "third_party/blink/renderer/platform/wtf/wtf.h"
@@ -243,7 +245,21 @@ class TokenPreloadScanner::StartTagScanner {
         PreloadRequest::kRequestTypePreload;
     std::optional<ResourceType> type;
 #ifdef BLINKIT_CRAWLER_ONLY
-    ASSERT(false); // BKTODO:
+    if (!ShouldPreload(type))
+      return nullptr;
+
+    TextPosition position =
+        TextPosition(source.CurrentLine(), source.CurrentColumn());
+    auto request = PreloadRequest::CreateIfNeeded(
+        InitiatorFor(tag_impl_), position, url_to_load_, predicted_base_url,
+        GetResourceType(), request_type);
+    if (!request)
+      return nullptr;
+
+    if (scanner_type_ == ScannerType::kInsertion)
+      request->SetFromInsertionScanner(true);
+
+    return request;
 #else
     if (ShouldPreconnect()) {
       request_type = PreloadRequest::kRequestTypePreconnect;
@@ -261,11 +277,7 @@ class TokenPreloadScanner::StartTagScanner {
         return nullptr;
       }
     }
-#endif
 
-    ASSERT(false); // BKTODO:
-    return nullptr;
-#if 0
     TextPosition position =
         TextPosition(source.CurrentLine(), source.CurrentColumn());
     FetchParameters::ResourceWidth resource_width;
@@ -951,13 +963,10 @@ void TokenPreloadScanner::UpdatePredictedBaseURL(const Token& token) {
   DCHECK(predicted_base_element_url_.IsEmpty());
   if (const typename Token::Attribute* href_attribute =
           token.GetAttributeItem(kHrefAttr)) {
-    ASSERT(false); // BKTODO:
-#if 0
-    BkURL url(document_url_, StripLeadingAndTrailingHTMLSpaces(
-                                href_attribute->Value8BitIfNecessary()));
+    BkURL url = document_url_.Resolve(
+        StripLeadingAndTrailingHTMLSpaces(href_attribute->Value()).StdUtf8());
     predicted_base_element_url_ =
-        url.IsValid() && !url.ProtocolIsData() ? url.Copy() : BkURL();
-#endif
+        url.IsValid() && !url.SchemeIsData() ? url : BkURL();
   }
 }
 
@@ -1016,7 +1025,10 @@ CachedDocumentParameters::CachedDocumentParameters(Document* document) {
   DCHECK(IsMainThread());
   DCHECK(document);
   do_html_preload_scanning = false;
-#ifndef BLINKIT_CRAWLER_ONLY
+#ifdef BLINKIT_CRAWLER_ONLY
+  if (ResourceFetcher* fetcher = document->Fetcher())
+    do_html_preload_scanning = fetcher->Context().SpeculativePreloadLimit() > 0;
+#else
   ASSERT(false); // BKTODO:
   do_html_preload_scanning =
       !document->GetSettings() ||
@@ -15,11 +15,102 @@
 
 #include "preload_request.h"
 
+#include "base/memory/ptr_util.h"
+#include "blinkit/crawler/crawler_impl.h"
+#include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/frame/local_frame.h"
+#include "third_party/blink/renderer/core/loader/resource/script_resource.h"
+#include "third_party/blink/renderer/platform/loader/fetch/fetch_parameters.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
+
+using namespace BlinKit;
+
 namespace blink {
 
+PreloadRequest::PreloadRequest(
+    const String &initiatorName,
+    const TextPosition &initiatorPosition,
+    const std::string &resourceURL,
+    const BkURL &baseURL,
+    ResourceType resourceType,
+    RequestType requestType)
+    : m_initiatorName(initiatorName)
+    , m_initiatorPosition(initiatorPosition)
+    , m_resourceURL(resourceURL)
+    , m_baseURL(baseURL)
+    , m_resourceType(resourceType)
+    , m_requestType(requestType)
+{
+}
+
+BkURL PreloadRequest::CompleteURL(Document *document) const
+{
+    if (!m_baseURL.IsEmpty())
+        return m_baseURL.Resolve(m_resourceURL);
+    return document->CompleteURL(String::FromUTF8(m_resourceURL.data(), m_resourceURL.length()));
+}
+
+std::unique_ptr<PreloadRequest> PreloadRequest::CreateIfNeeded(
+    const String &initiatorName,
+    const TextPosition &initiatorPosition,
+    const String &resourceURL,
+    const BkURL &baseURL,
+    ResourceType resourceType,
+    RequestType requestType)
+{
+    // Only scripts are fetched speculatively for now, they are the ones which
+    // block the parser.
+    if (ResourceType::kScript != resourceType)
+        return nullptr;
+
+    const std::string url = resourceURL.StdUtf8();
+    // Data URLs are filtered out in the preload scanner.
+    BkURL completedURL = baseURL.IsEmpty() ? BkURL(url) : baseURL.Resolve(url);
+    if (completedURL.IsValid() && completedURL.SchemeIsData())
+        return nullptr;
+
+    return base::WrapUnique(new PreloadRequest(initiatorName.IsolatedCopy(), initiatorPosition, url, baseURL,
+        resourceType, requestType));
+}
+
 Resource* PreloadRequest::Start(Document *document)
 {
-    ASSERT(false); // BKTODO:
+    DCHECK(IsMainThread());
+
+    BkURL url = CompleteURL(document);
+    if (!url.IsValid() || url.SchemeIsData())
+        return nullptr;
+
+    ResourceFetcher *fetcher = document->Fetcher();
+    if (nullptr == fetcher || nullptr == document->GetFrame())
+        return nullptr;
+
+    ResourceRequest request(url);
+    if (document->ForCrawler())
+    {
+        // Hijacking is honored the same way as ClassicPendingScript::Fetch does.
+        CrawlerImpl *crawler = ToCrawlerImpl(document->GetFrame()->Client());
+        request.SetCrawler(crawler);
+        request.SetHijackType(HijackType::kScript);
+    }
+
+    ResourceLoaderOptions options;
+    options.initiator_info.name = AtomicString(m_initiatorName);
+    options.initiator_info.position = m_initiatorPosition;
+
+    FetchParameters params(request, options);
+    params.SetSpeculativePreloadType(m_fromInsertionScanner
+        ? FetchParameters::SpeculativePreloadType::kInserted
+        : FetchParameters::SpeculativePreloadType::kInDocument);
+
+    switch (m_resourceType)
+    {
+        case ResourceType::kScript:
+            return ScriptResource::Fetch(params, fetcher, nullptr).get();
+        default:
+            NOTREACHED();
+    }
     return nullptr;
 }
 
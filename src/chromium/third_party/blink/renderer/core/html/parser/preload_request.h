@@ -18,13 +18,20 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
+#include "blinkit/common/bk_url.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource.h"
+#include "third_party/blink/renderer/platform/wtf/text/text_position.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 
 namespace blink {
 
 class Document;
-class Resource;
 
+// Created by the preload scanner, possibly on the parser thread, and started
+// on the main thread. URLs are kept as std::string so a request can be moved
+// across threads.
 class PreloadRequest
 {
 public:
@@ -34,7 +41,29 @@ public:
         kRequestTypeLinkRelPreload
     };
 
+    static std::unique_ptr<PreloadRequest> CreateIfNeeded(const String &initiatorName, const TextPosition &initiatorPosition,
+        const String &resourceURL, const BlinKit::BkURL &baseURL, ResourceType resourceType, RequestType requestType);
+
     Resource* Start(Document *document);
+
+    void SetFromInsertionScanner(bool fromInsertionScanner) { m_fromInsertionScanner = fromInsertionScanner; }
+
+    const std::string& ResourceURL(void) const { return m_resourceURL; }
+    ResourceType GetResourceType(void) const { return m_resourceType; }
+    bool IsLinkRelPreload(void) const { return kRequestTypeLinkRelPreload == m_requestType; }
+private:
+    PreloadRequest(const String &initiatorName, const TextPosition &initiatorPosition, const std::string &resourceURL,
+        const BlinKit::BkURL &baseURL, ResourceType resourceType, RequestType requestType);
+
+    BlinKit::BkURL CompleteURL(Document *document) const;
+
+    const String m_initiatorName;
+    const TextPosition m_initiatorPosition;
+    const std::string m_resourceURL;
+    const BlinKit::BkURL m_baseURL;
+    const ResourceType m_resourceType;
+    const RequestType m_requestType;
+    bool m_fromInsertionScanner = false;
 };
 
 typedef std::vector<std::unique_ptr<PreloadRequest>> PreloadRequestStream;
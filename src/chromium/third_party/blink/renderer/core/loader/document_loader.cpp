@@ -51,6 +51,7 @@
 #include "third_party/blink/renderer/core/loader/frame_fetch_context.h"
 #include "third_party/blink/renderer/platform/bindings/script_forbidden_scope.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_parameters.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_error.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loader_options.h"
 #include "third_party/blink/renderer/platform/network/http_names.h"
@@ -443,7 +444,7 @@ void DocumentLoader::StopLoading(void)
 {
     m_fetcher->StopFetching();
     if (m_frame && !SentDidFinishLoad())
-        ASSERT(false); // BKTODO: LoadFailed(ResourceError::CancelledError(Url()));
+        LoadFailed(ResourceError(BK_ERR_CANCELLED, Url()));
 }
 
 void DocumentLoader::WillCommitNavigation(void)
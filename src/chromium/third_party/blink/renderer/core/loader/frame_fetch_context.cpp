@@ -41,6 +41,7 @@
 
 #include "frame_fetch_context.h"
 
+#include "blinkit/crawler/crawler_impl.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/frame/local_frame_client.h"
@@ -237,6 +238,24 @@ void FrameFetchContext::SetFirstPartyCookie(ResourceRequest &request)
         request.SetSiteForCookies(request.Url());
 }
 
+std::optional<ResourceRequestBlockedReason> FrameFetchContext::CanRequest(
+    ResourceType type,
+    const ResourceRequest &resourceRequest,
+    const BlinKit::BkURL &url,
+    const ResourceLoaderOptions &options,
+    ResourceRequest::RedirectStatus redirectStatus) const
+{
+    std::optional<ResourceRequestBlockedReason> blockedReason = BaseFetchContext::CanRequest(type, resourceRequest, url,
+        options, redirectStatus);
+    if (blockedReason || IsDetached())
+        return blockedReason;
+
+    LocalFrameClient *client = GetLocalFrameClient();
+    if (client->IsCrawler() && !ToCrawlerImpl(client)->AllowsLoad(type, url))
+        return ResourceRequestBlockedReason::kSubresourceFilter;
+    return std::nullopt;
+}
+
 bool FrameFetchContext::ShouldLoadNewResource(ResourceType type) const
 {
     if (!m_documentLoader)
@@ -251,4 +270,15 @@ bool FrameFetchContext::ShouldLoadNewResource(ResourceType type) const
     return loader.GetDocumentLoader() == m_documentLoader;
 }
 
+unsigned FrameFetchContext::SpeculativePreloadLimit(void) const
+{
+    if (IsDetached())
+        return 0;
+
+    LocalFrameClient *client = GetLocalFrameClient();
+    if (!client->IsCrawler())
+        return BaseFetchContext::SpeculativePreloadLimit();
+    return ToCrawlerImpl(client)->SpeculativePreloadLimit();
+}
+
 }  // namespace blink
@@ -81,7 +81,10 @@ private:
     bool IsFrameFetchContext(void) override { return true; }
     void RecordDataUriWithOctothorpe(void) override;
     void PrepareRequest(ResourceRequest &request, RedirectType redirectType) override;
+    std::optional<ResourceRequestBlockedReason> CanRequest(ResourceType type, const ResourceRequest &resourceRequest,
+        const BlinKit::BkURL &url, const ResourceLoaderOptions &options, ResourceRequest::RedirectStatus redirectStatus) const override;
     bool ShouldLoadNewResource(ResourceType type) const override;
+    unsigned SpeculativePreloadLimit(void) const override;
     void DispatchDidReceiveResponse(unsigned long identifier, const ResourceResponse &response,
         Resource *resource) override;
     void DidLoadResource(Resource *resource) override;
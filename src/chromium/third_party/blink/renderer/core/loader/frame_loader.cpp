@@ -281,6 +281,18 @@ void FrameLoader::DispatchUnloadEvent(void)
         document->DispatchUnloadEvents();
 }
 
+void FrameLoader::ParserFinished(void)
+{
+    if (m_stateMachine.CreatingInitialEmptyDocument())
+        return;
+
+    if (LocalFrameClient *client = Client())
+    {
+        ScriptForbiddenScope forbidScripts;
+        client->DispatchDidParseDocument();
+    }
+}
+
 void FrameLoader::FinishedParsing(void)
 {
     if (m_stateMachine.CreatingInitialEmptyDocument())
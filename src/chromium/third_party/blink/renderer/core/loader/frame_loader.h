@@ -89,6 +89,7 @@ public:
         std::unique_ptr<WebDocumentLoader::ExtraData> extraData = nullptr);
     bool PrepareForCommit(void);
     void CommitProvisionalLoad(void);
+    void ParserFinished(void);
     void FinishedParsing(void);
     void DidFinishNavigation(void);
     void DetachProvisionalDocumentLoader(DocumentLoader *loader);
@@ -15,7 +15,8 @@
 
 namespace blink {
 
-static unsigned s_scriptForbiddenCount = 0;
+// Each engine thread of the pool mode has a count of its own.
+static thread_local unsigned s_scriptForbiddenCount = 0;
 
 void ScriptForbiddenScope::Enter(void)
 {
@@ -62,6 +62,12 @@ void Platform::AttachMainThread(Thread *thread)
     m_threads[thread->ThreadId()] = thread;
 }
 
+void Platform::AttachThread(Thread *thread)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_threads[thread->ThreadId()] = thread;
+}
+
 std::unique_ptr<WebURLLoader> Platform::CreateURLLoader(const std::shared_ptr<base::SingleThreadTaskRunner> &taskRunner)
 {
     NOTREACHED();
@@ -79,6 +85,12 @@ Thread* Platform::CurrentThread(void)
     return nullptr;
 }
 
+void Platform::DetachThread(Thread *thread)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_threads.erase(thread->ThreadId());
+}
+
 void Platform::Initialize(Platform *platform, scheduler::WebThreadScheduler *mainThreadScheduler)
 {
     DCHECK(!g_platform);
@@ -37,12 +37,18 @@
 #include "language.h"
 
 #include "third_party/blink/public/platform/platform.h"
+#include "third_party/blink/renderer/platform/wtf/thread_specific.h"
 #include "third_party/blink/renderer/platform/wtf/wtf.h"
 
 namespace blink {
 
-// Main thread static AtomicString. This can be safely shared across threads.
-const AtomicString *g_platformLanguage = nullptr;
+// AtomicStrings belong to the engine thread which created them, so each engine
+// thread keeps its own copy of the platform language.
+static AtomicString& PlatformLanguage(void)
+{
+    DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<AtomicString>, s_platformLanguage, ());
+    return *s_platformLanguage;
+}
 
 static AtomicString CanonicalizePlatformLanguage(void)
 {
@@ -50,33 +56,26 @@ static AtomicString CanonicalizePlatformLanguage(void)
     if (!s.IsEmpty())
     {
         s.Replace('_', '-');
-
-        const LChar *chars = s.Characters8();
-        const unsigned length = s.length();
-        const unsigned hash = StringHasher::ComputeHashAndMaskTop8Bits(chars, length);
-        StringImpl *impl = StringImpl::CreateStatic(reinterpret_cast<const char *>(chars), length, hash);
-        return AtomicString(impl);
+        return AtomicString(s);
     }
     return AtomicString();
 }
 
 void InitializePlatformLanguage(void)
 {
-    assert(IsMainThread());
-    static const AtomicString s_platformLanguage = CanonicalizePlatformLanguage();
-    g_platformLanguage = &s_platformLanguage;
+    PlatformLanguage() = CanonicalizePlatformLanguage();
 }
 
 AtomicString DefaultLanguage(void)
 {
-    return *g_platformLanguage;
+    return PlatformLanguage();
 }
 
 Vector<AtomicString> UserPreferredLanguages(void)
 {
     Vector<AtomicString> languages;
     languages.ReserveInitialCapacity(1);
-    languages.push_back(*g_platformLanguage);
+    languages.push_back(PlatformLanguage());
     return languages;
 }
 
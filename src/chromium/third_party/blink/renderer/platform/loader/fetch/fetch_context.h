@@ -93,6 +93,10 @@ public:
 
     virtual bool ShouldLoadNewResource(ResourceType type) const { return false; }
 
+    // The maximum number of speculative preloads which may be in flight at the
+    // same time.
+    virtual unsigned SpeculativePreloadLimit(void) const { return 0; }
+
     // The last callback before a request is actually sent to the browser process.
     // TODO(https://crbug.com/632580): make this take const ResourceRequest&.
     virtual void DispatchWillSendRequest(unsigned long identifier, ResourceRequest &request,
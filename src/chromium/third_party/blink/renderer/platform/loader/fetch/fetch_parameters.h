@@ -74,9 +74,11 @@ public:
     bool IsLinkPreload(void) const { return m_options.initiator_info.is_link_preload; }
     
     SpeculativePreloadType GetSpeculativePreloadType(void) const { return m_speculativePreloadType; }
+    void SetSpeculativePreloadType(SpeculativePreloadType speculativePreloadType) { m_speculativePreloadType = speculativePreloadType; }
     bool IsSpeculativePreload(void) const { return SpeculativePreloadType::kNotSpeculative != m_speculativePreloadType; }
 
     DeferOption Defer(void) const { return m_defer; }
+    void SetDefer(DeferOption defer) { m_defer = defer; }
 
     bool IsStaleRevalidation(void) const { return m_isStaleRevalidation; }
     void SetStaleRevalidation(bool isStaleRevalidation) { m_isStaleRevalidation = isStaleRevalidation; }
@@ -35,6 +35,7 @@
 
 #include "resource.h"
 
+#include "base/single_thread_task_runner.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_client.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loader.h"
 #include "third_party/blink/renderer/platform/loader/fetch/cached_metadata_handler.h"
@@ -88,15 +89,18 @@ void Resource::AddClient(ResourceClient *client, base::SingleThreadTaskRunner *t
     // and the resource type supports it, send it asynchronously.
     if ((ErrorOccurred() || !GetResponse().IsNull()) && !NeedsSynchronousCacheHit(GetType(), m_options))
     {
-        ASSERT(false); // BKTODO:
-#if 0
-        clients_awaiting_callback_.insert(client);
-        if (!async_finish_pending_clients_task_.IsActive()) {
-            async_finish_pending_clients_task_ = PostCancellableTask(
-                *task_runner, FROM_HERE,
-                WTF::Bind(&Resource::FinishPendingClients, WrapWeakPersistent(this)));
+        m_clientsAwaitingCallback.insert(client);
+        if (!m_asyncFinishPendingClientsTask)
+        {
+            m_asyncFinishPendingClientsTask = std::make_shared<Resource *>(this);
+
+            std::weak_ptr<Resource *> task = m_asyncFinishPendingClientsTask;
+            std::function<void()> callback = [task] {
+                if (std::shared_ptr<Resource *> resource = task.lock())
+                    (*resource)->FinishPendingClients();
+            };
+            taskRunner->PostTask(FROM_HERE, callback);
         }
-#endif
         return;
     }
 
@@ -138,35 +142,57 @@ void Resource::DidAddClient(ResourceClient *c)
 {
     if (std::shared_ptr<SharedBuffer> data = Data())
     {
-        ASSERT(false); // BKTODO:
-#if 0
-        for (const auto& span : *data) {
-            c->DataReceived(this, span.data(), span.size());
+        for (auto it = data->begin(); it != data->end(); ++it)
+        {
+            c->DataReceived(this, it.data(), it.size());
             // Stop pushing data if the client removed itself.
             if (!HasClient(c))
                 break;
         }
-#endif
     }
     if (!HasClient(c))
         return;
     if (IsLoaded())
     {
-        ASSERT(false); // BKTODO:
-#if 0
         c->NotifyFinished(this);
-        if (clients_.Contains(c)) {
-            finished_clients_.insert(c);
-            clients_.erase(c);
-        }
-#endif
+        MarkClientFinished(c);
     }
-    BKLOG("// BKTODO: Check child classes.");
 }
 
 void Resource::DidChangePriority(ResourceLoadPriority loadPriority, int intraPriorityValue)
 {
-    ASSERT(false); // BKTODO:
+    // Requests are not reprioritized once they are on the wire, only the
+    // recorded priority is updated.
+    m_resourceRequest.SetPriority(loadPriority, intraPriorityValue);
+}
+
+void Resource::FinishPendingClients(void)
+{
+    // We're going to notify clients one by one. It is simple if the client does
+    // nothing. However there are a couple other things that can happen.
+    // 1. Clients can be added during the loop. Make sure they are not processed.
+    // 2. Clients can be removed during the loop. Make sure they are always
+    //    available to be removed. Also don't call removed clients or add them
+    //    back.
+    //
+    // Handle case (1) by saving a list of clients to notify. A separate list also
+    // ensure a client is either in m_clients or m_clientsAwaitingCallback.
+    std::vector<ResourceClient *> clientsToNotify(m_clientsAwaitingCallback.begin(), m_clientsAwaitingCallback.end());
+    m_asyncFinishPendingClientsTask.reset();
+
+    for (ResourceClient *client : clientsToNotify)
+    {
+        // Handle case (2) to skip removed clients.
+        if (0 == m_clientsAwaitingCallback.erase(client))
+            continue;
+        m_clients.insert(client);
+
+        // When revalidation starts after waiting clients are scheduled and
+        // before they are added here. In such cases, we just add the clients
+        // to |m_clients| without DidAddClient(), as in Resource::AddClient().
+        if (!m_isRevalidating)
+            DidAddClient(client);
+    }
 }
 
 void Resource::DidRemoveClientOrObserver(void)
@@ -224,8 +250,6 @@ void Resource::FinishAsError(const ResourceError &error, base::SingleThreadTaskR
     // BKTODO: CheckResourceIntegrity();
     TriggerNotificationForFinishObservers(taskRunner);
 
-    ASSERT(!failedDuringStart); // BKTODO:
-#if 0
     // Most resource types don't expect to succeed or fail inside
     // ResourceFetcher::RequestResource(). If the request does complete
     // immediately, the convention is to notify the client asynchronously
@@ -233,16 +257,21 @@ void Resource::FinishAsError(const ResourceError &error, base::SingleThreadTaskR
     // performance implications to making those notifications asynchronous).
     // So if this is an immediate failure (i.e., before NotifyStartLoad()),
     // post a task if the Resource::Type supports it.
-    if (failed_during_start && !NeedsSynchronousCacheHit(GetType(), options_)) {
-        task_runner->PostTask(FROM_HERE, WTF::Bind(&Resource::NotifyFinished,
-            WrapWeakPersistent(this)));
+    if (failedDuringStart && !NeedsSynchronousCacheHit(GetType(), m_options))
+    {
+        m_asyncNotifyFinishedTask = std::make_shared<Resource *>(this);
+
+        std::weak_ptr<Resource *> task = m_asyncNotifyFinishedTask;
+        std::function<void()> callback = [task] {
+            if (std::shared_ptr<Resource *> resource = task.lock())
+                (*resource)->NotifyFinished();
+        };
+        taskRunner->PostTask(FROM_HERE, callback);
     }
-    else {
+    else
+    {
         NotifyFinished();
     }
-#else
-    NotifyFinished();
-#endif
     // BKTODO: Check image overrides
 }
 
@@ -250,24 +279,14 @@ bool Resource::HasClient(ResourceClient * client) const
 {
     if (m_clients.find(client) != std::end(m_clients))
         return true;
-    ASSERT(false); // BKTODO:
-#if 0
-    return clients_awaiting_callback_.Contains(client) ||
-        finished_clients_.Contains(client);
-#endif
-    return false;
+    return m_clientsAwaitingCallback.find(client) != std::end(m_clientsAwaitingCallback)
+        || m_finishedClients.find(client) != std::end(m_finishedClients);
 }
 
 bool Resource::HasClientsOrObservers(void) const
 {
-    if (m_clients.empty())
-        return false;
-    ASSERT(false); // BKTODO:
-#if 0
-    return !clients_awaiting_callback_.IsEmpty() ||
-        !finished_clients_.IsEmpty() || !finish_observers_.IsEmpty();
-#endif
-    return true;
+    return !m_clients.empty() || !m_clientsAwaitingCallback.empty() || !m_finishedClients.empty()
+        || !m_finishObservers.empty();
 }
 
 bool Resource::IsLoadEventBlockingResourceType(void) const
@@ -335,12 +354,8 @@ void Resource::RemoveClient(ResourceClient *client)
             m_clients.erase(client);
     }
 
-#if 0 // BKTODO:
-    if (clients_awaiting_callback_.IsEmpty() &&
-        async_finish_pending_clients_task_.IsActive()) {
-        async_finish_pending_clients_task_.Cancel();
-    }
-#endif
+    if (m_clientsAwaitingCallback.empty())
+        m_asyncFinishPendingClientsTask.reset();
 
     DidRemoveClientOrObserver();
 }
@@ -105,6 +105,7 @@ public:
     bool IsCacheValidator(void) const { return m_isRevalidating; }
 
     const std::unordered_set<ResourceClient *>& Clients(void) const { return m_clients; }
+    virtual bool HasClientsOrObservers(void) const;
     const ResourceLoaderOptions& Options(void) const { return m_options; }
 
     const ResourceRequest& GetResourceRequest(void) const { return m_resourceRequest; }
@@ -187,7 +188,6 @@ protected:
     virtual void SetEncoding(const String &encoding) {}
 
     void WillAddClientOrObserver(void);
-    virtual bool HasClientsOrObservers(void) const;
     virtual void DidAddClient(ResourceClient *c);
     void DidRemoveClientOrObserver(void);
     virtual void AllClientsAndObserversRemoved(void);
@@ -196,6 +196,7 @@ protected:
 
     CachedMetadataHandler* CacheHandler(void) { return m_cacheHandler.get(); }
 private:
+    void FinishPendingClients(void);
     void TriggerNotificationForFinishObservers(base::SingleThreadTaskRunner *taskRunner);
 
     ResourceType m_type;
@@ -220,6 +221,10 @@ private:
     std::unordered_set<ResourceClient *> m_clientsAwaitingCallback;
     std::unordered_set<ResourceClient *> m_finishedClients;
     std::unordered_set<ResourceFinishObserver *> m_finishObservers;
+    // Alive while a FinishPendingClients task is posted, reset to cancel it.
+    std::shared_ptr<Resource *> m_asyncFinishPendingClientsTask;
+    // Alive while a NotifyFinished task is posted for a failure during start.
+    std::shared_ptr<Resource *> m_asyncNotifyFinishedTask;
 
     ResourceLoaderOptions m_options;
 
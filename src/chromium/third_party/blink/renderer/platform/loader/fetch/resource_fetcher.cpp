@@ -38,6 +38,7 @@
 
 #include "resource_fetcher.h"
 
+#include "bk_def.h"
 #include "third_party/blink/renderer/platform/bindings/script_forbidden_scope.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_context.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource.h"
@@ -67,7 +68,7 @@ void ResourceFetcher::ClearContext(void)
 {
     ASSERT(m_resourcesFromPreviousFetcher.empty());
     // BKTODO: m_scheduler->Shutdown();
-    // BKTODO: ClearPreloads(ResourceFetcher::kClearAllPreloads);
+    ClearPreloads();
     FetchContext *detachedContext = Context().Detach();
     if (detachedContext != m_context.get())
         m_context.reset(detachedContext);
@@ -220,10 +221,19 @@ std::shared_ptr<Resource> ResourceFetcher::CreateResourceForLoading(
     return resource;
 }
 
+void ResourceFetcher::ClearPreloads(void)
+{
+    m_preloads.clear();
+    m_pendingPreloads.clear();
+}
+
 void ResourceFetcher::HandleLoadCompletion(Resource *resource)
 {
     Context().DidLoadResource(resource);
 
+    if (0 != m_inflightPreloads.erase(resource))
+        StartPendingPreloads();
+
 #if 0 // BKTODO:
     resource->ReloadIfLoFiOrPlaceholderImage(this, Resource::kReloadIfNeeded);
 #endif
@@ -308,20 +318,46 @@ void ResourceFetcher::HandleLoaderFinish(Resource *resource, LoaderFinishType ty
     HandleLoadCompletion(resource);
 }
 
-void ResourceFetcher::InsertAsPreloadIfNecessary(Resource *resource, const FetchParameters &params, ResourceType type)
+static BkURL RemoveFragmentIdentifierIfNeeded(const BkURL &originalUrl)
+{
+    if (!originalUrl.HasRef() || !originalUrl.SchemeIsHTTPOrHTTPS())
+        return originalUrl;
+    return originalUrl.StripFragmentIdentifier();
+}
+
+void ResourceFetcher::InsertAsPreloadIfNecessary(
+    const std::shared_ptr<Resource> &resource,
+    const FetchParameters &params,
+    ResourceType type)
 {
     if (!params.IsSpeculativePreload() && !params.IsLinkPreload())
         return;
-    ASSERT(false); // BKTODO:
+
+    ASSERT(resource->GetType() == type);
+    const std::string key = RemoveFragmentIdentifierIfNeeded(params.Url()).AsString();
+    if (std::end(m_preloads) == m_preloads.find(key))
+        m_preloads.emplace(key, resource);
 }
 
-static BkURL RemoveFragmentIdentifierIfNeeded(const BkURL &originalUrl)
+std::shared_ptr<Resource> ResourceFetcher::MatchPreload(const FetchParameters &params, ResourceType type)
 {
-    if (!originalUrl.HasRef() || !originalUrl.SchemeIsHTTPOrHTTPS())
-        return originalUrl;
-    BkURL url = originalUrl;
-    ASSERT(false); // BKTODO: url.RemoveFragmentIdentifier();
-    return url;
+    auto it = m_preloads.find(RemoveFragmentIdentifierIfNeeded(params.Url()).AsString());
+    if (std::end(m_preloads) == it)
+        return nullptr;
+
+    std::shared_ptr<Resource> resource = it->second;
+    if (resource->GetType() != type)
+        return nullptr;
+
+    if (params.IsSpeculativePreload())
+        return resource;
+
+    m_preloads.erase(it);
+    // A failed preload is fetched again, so that the real request gets its own
+    // error.
+    if (resource->ErrorOccurred())
+        return nullptr;
+    return resource;
 }
 
 std::optional<ResourceRequestBlockedReason> ResourceFetcher::PrepareRequest(
@@ -424,7 +460,11 @@ std::shared_ptr<Resource> ResourceFetcher::RequestResource(
     RevalidationPolicy policy = kLoad;
 
 #ifdef BLINKIT_CRAWLER_ONLY
-    resource = CreateResourceForLoading(params, factory);
+    resource = MatchPreload(params, resourceType);
+    if (resource)
+        policy = kUse;
+    else
+        resource = CreateResourceForLoading(params, factory);
 #else
     bool is_data_url = resource_request.Url().ProtocolIsData();
     bool is_static_data = is_data_url || substitute_data.IsValid() || archive_;
@@ -528,7 +568,13 @@ std::shared_ptr<Resource> ResourceFetcher::RequestResource(
     // start loading.
     if (ResourceNeedsLoad(resource.get(), params, policy))
     {
-        if (!StartLoad(resource))
+        if (params.IsSpeculativePreload())
+        {
+            // A speculative request for a known preload is a no-op.
+            if (kUse != policy)
+                StartOrQueuePreload(resource);
+        }
+        else if (!StartLoad(resource))
         {
             ASSERT(false); // BKTODO:
 #if 0
@@ -539,7 +585,7 @@ std::shared_ptr<Resource> ResourceFetcher::RequestResource(
     }
 
     if (policy != kUse)
-        InsertAsPreloadIfNecessary(resource.get(), params, resourceType);
+        InsertAsPreloadIfNecessary(resource, params, resourceType);
 
     return resource;
 }
@@ -556,12 +602,7 @@ std::shared_ptr<Resource> ResourceFetcher::ResourceForBlockedRequest(
         params.DecoderOptions());
     if (nullptr != client)
         client->SetResource(resource, taskRunner.get());
-    ASSERT(false); // BKTODO:
-#if 0
-    resource->FinishAsError(ResourceError::CancelledDueToAccessCheckError(
-        params.Url(), blocked_reason),
-        Context().GetLoadingTaskRunner().get());
-#endif
+    resource->FinishAsError(ResourceError(BK_ERR_FORBIDDEN, params.Url()), taskRunner.get());
     return resource;
 }
 
@@ -622,6 +663,13 @@ bool ResourceFetcher::ResourceNeedsLoad(Resource *resource, const FetchParameter
     return policy != kUse || resource->StillNeedsLoad();
 }
 
+unsigned ResourceFetcher::SpeculativePreloadLimit(void)
+{
+    if (!m_speculativePreloadLimit.has_value())
+        m_speculativePreloadLimit = Context().SpeculativePreloadLimit();
+    return m_speculativePreloadLimit.value();
+}
+
 bool ResourceFetcher::StartLoad(std::shared_ptr<Resource> &resource)
 {
     ASSERT(nullptr != resource);
@@ -694,6 +742,35 @@ bool ResourceFetcher::StartLoad(std::shared_ptr<Resource> &resource)
     return true;
 }
 
+void ResourceFetcher::StartOrQueuePreload(std::shared_ptr<Resource> &resource)
+{
+    if (m_inflightPreloads.size() >= SpeculativePreloadLimit())
+    {
+        m_pendingPreloads.push_back(resource);
+        return;
+    }
+
+    if (StartLoad(resource))
+        m_inflightPreloads.insert(resource.get());
+}
+
+void ResourceFetcher::StartPendingPreloads(void)
+{
+    const unsigned limit = SpeculativePreloadLimit();
+    while (m_inflightPreloads.size() < limit && !m_pendingPreloads.empty())
+    {
+        std::shared_ptr<Resource> resource = m_pendingPreloads.front();
+        m_pendingPreloads.pop_front();
+
+        // Already started by a parser request which matched it.
+        if (!resource->StillNeedsLoad())
+            continue;
+
+        if (StartLoad(resource))
+            m_inflightPreloads.insert(resource.get());
+    }
+}
+
 void ResourceFetcher::StopFetching(void)
 {
     StopFetchingInternal(StopFetchingTarget::kExcludingKeepaliveLoaders);
@@ -701,35 +778,22 @@ void ResourceFetcher::StopFetching(void)
 
 void ResourceFetcher::StopFetchingInternal(StopFetchingTarget target)
 {
-    if (StopFetchingTarget::kIncludingKeepaliveLoaders != target)
-        return;
-
     // TODO(toyoshim): May want to suspend scheduler while canceling loaders so
     // that the cancellations below do not awake unnecessary scheduling.
 
-    ASSERT(false); // BKTODO:
-#if 0
-    std::vector<ResourceLoader *> loadersToCancel;
-    for (const auto &loader : m_nonBlockingLoaders)
-    {
-        ASSERT(false); // BKTODO:
-        if (target == StopFetchingTarget::kIncludingKeepaliveLoaders ||
-            !loader->ShouldBeKeptAliveWhenDetached()) {
-            loaders_to_cancel.push_back(loader);
-        }
-    }
-    for (const auto& loader : loaders_) {
-        if (target == StopFetchingTarget::kIncludingKeepaliveLoaders ||
-            !loader->ShouldBeKeptAliveWhenDetached()) {
-            loaders_to_cancel.push_back(loader);
-        }
-    }
+    // Crawlers make no keepalive requests, so both targets cancel everything.
+    std::vector<ResourceLoader *> loadersToCancel(m_nonBlockingLoaders.begin(), m_nonBlockingLoaders.end());
+    loadersToCancel.insert(loadersToCancel.end(), m_loaders.begin(), m_loaders.end());
 
-    for (const auto& loader : loaders_to_cancel) {
-        if (loaders_.Contains(loader) || non_blocking_loaders_.Contains(loader))
+    // A cancellation may finish other loaders, e.g. by detaching the document loader.
+    for (ResourceLoader *loader : loadersToCancel)
+    {
+        if (std::end(m_loaders) != m_loaders.find(loader)
+            || std::end(m_nonBlockingLoaders) != m_nonBlockingLoaders.find(loader))
+        {
             loader->Cancel();
+        }
     }
-#endif
 }
 
 }  // namespace blink
@@ -40,7 +40,9 @@
 
 #pragma once
 
+#include <deque>
 #include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include "base/memory/ptr_util.h"
 #include "third_party/blink/public/platform/resource_request_blocked_reason.h"
@@ -110,7 +112,16 @@ private:
     std::shared_ptr<Resource> ResourceForBlockedRequest(const FetchParameters &params, const ResourceFactory &factory,
         ResourceRequestBlockedReason blockedReason, ResourceClient *client);
 
-    void InsertAsPreloadIfNecessary(Resource *resource, const FetchParameters &params, ResourceType type);
+    void InsertAsPreloadIfNecessary(const std::shared_ptr<Resource> &resource, const FetchParameters &params,
+        ResourceType type);
+    std::shared_ptr<Resource> MatchPreload(const FetchParameters &params, ResourceType type);
+    void ClearPreloads(void);
+
+    // Speculative preloads are throttled by FetchContext::SpeculativePreloadLimit(),
+    // the ones over the limit wait in |m_pendingPreloads| for a free slot.
+    unsigned SpeculativePreloadLimit(void);
+    void StartOrQueuePreload(std::shared_ptr<Resource> &resource);
+    void StartPendingPreloads(void);
 
     enum RevalidationPolicy { kUse, kRevalidate, kReload, kLoad };
 
@@ -138,6 +149,13 @@ private:
     // the previous page. Unpopulated unless experiment is enabled.
     std::unordered_set<Resource *> m_resourcesFromPreviousFetcher;
 
+    // Preloaded resources, keyed by URL without the fragment identifier. Each
+    // one is handed to the first matching non-speculative request.
+    std::unordered_map<std::string, std::shared_ptr<Resource>> m_preloads;
+    std::deque<std::shared_ptr<Resource>> m_pendingPreloads;
+    std::unordered_set<Resource *> m_inflightPreloads;
+    std::optional<unsigned> m_speculativePreloadLimit;
+
     bool m_imageFetched : 1;
 
     uint32_t m_inflightKeepaliveBytes = 0;
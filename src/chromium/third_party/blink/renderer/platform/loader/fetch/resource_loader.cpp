@@ -41,11 +41,14 @@
 #include "resource_loader.h"
 
 #include "base/memory/ptr_util.h"
+#include "base/single_thread_task_runner.h"
+#include "bk_def.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/public/platform/web_url_loader.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_context.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_error.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_loader_options.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_response.h"
@@ -81,9 +84,18 @@ void ResourceLoader::ActivateCacheAwareLoadingIfNeeded(const ResourceRequest & r
 
 void ResourceLoader::Cancel(void)
 {
-    ASSERT(false); // BKTODO:
+    // The resource may go with this loader.
+    std::shared_ptr<Resource> protect = m_resource;
+    HandleError(ResourceError(BK_ERR_CANCELLED, m_resource->Url()));
 }
 
+void ResourceLoader::CancelTimerFired(void)
+{
+    m_cancelTask.reset();
+    if (m_loader && !m_resource->HasClientsOrObservers())
+        Cancel();
+}
+
 FetchContext& ResourceLoader::Context(void) const
 {
     return m_fetcher->Context();
@@ -201,7 +213,16 @@ void ResourceLoader::HandleError(const ResourceError &error)
 
 void ResourceLoader::ScheduleCancel(void)
 {
-    ASSERT(false); // BKTODO:
+    if (m_cancelTask)
+        return;
+    m_cancelTask = std::make_shared<ResourceLoader *>(this);
+
+    std::weak_ptr<ResourceLoader *> task = m_cancelTask;
+    std::function<void()> callback = [task] {
+        if (std::shared_ptr<ResourceLoader *> loader = task.lock())
+            (*loader)->CancelTimerFired();
+    };
+    Context().GetLoadingTaskRunner()->PostTask(FROM_HERE, callback);
 }
 
 void ResourceLoader::SetDefersLoading(bool defers)
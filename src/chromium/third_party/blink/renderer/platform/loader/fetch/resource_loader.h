@@ -74,6 +74,7 @@ private:
     ResourceLoader(ResourceFetcher *fetcher, std::shared_ptr<Resource> &resource, uint32_t inflightKeepaliveBytes);
 
     FetchContext& Context(void) const;
+    void CancelTimerFired(void);
     bool ShouldFetchCodeCache(void);
     void StartWith(const ResourceRequest &request);
 
@@ -86,6 +87,8 @@ private:
     std::unique_ptr<WebURLLoader> m_loader;
     Member<ResourceFetcher> m_fetcher;
     std::shared_ptr<Resource> m_resource;
+    // Alive while a task to cancel the load is posted, see ScheduleCancel.
+    std::shared_ptr<ResourceLoader *> m_cancelTask;
 
     bool m_isCacheAwareLoadingActivated = false;
     bool m_isDownloadingToBlob = false;
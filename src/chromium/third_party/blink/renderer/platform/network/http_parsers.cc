@@ -52,6 +52,7 @@
 #include "third_party/blink/renderer/platform/network/http_names.h"
 #include "third_party/blink/renderer/platform/wtf/date_math.h"
 #include "third_party/blink/renderer/platform/wtf/math_extras.h"
+#include "third_party/blink/renderer/platform/wtf/thread_specific.h"
 #include "third_party/blink/renderer/platform/wtf/text/character_names.h"
 #include "third_party/blink/renderer/platform/wtf/text/cstring.h"
 #include "third_party/blink/renderer/platform/wtf/text/parsing_utilities.h"
@@ -67,11 +68,15 @@ namespace {
 const Vector<AtomicString>& ReplaceHeaders() {
   // The list of response headers that we do not copy from the original
   // response when generating a ResourceResponse for a MIME payload.
-  // Note: this is called only on the main thread.
-  DEFINE_STATIC_LOCAL(Vector<AtomicString>, headers,
-                      ({"content-type", "content-length", "content-disposition",
-                        "content-range", "range", "set-cookie"}));
-  return headers;
+  // AtomicStrings belong to the engine thread that created them, so every
+  // engine thread keeps its own copy of the list.
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(ThreadSpecific<Vector<AtomicString>>,
+                                  headers, ());
+  if (headers->IsEmpty()) {
+    *headers = {"content-type", "content-length", "content-disposition",
+                "content-range", "range",        "set-cookie"};
+  }
+  return *headers;
 }
 
 bool IsWhitespace(UChar chr) {
@@ -284,22 +289,19 @@ ReflectedXSSDisposition ParseXSSProtectionHeader(const String& header,
                                                  String& failure_reason,
                                                  unsigned& failure_position,
                                                  String& report_url) {
-  DEFINE_STATIC_LOCAL(String, failure_reason_invalid_toggle,
-                      ("expected token to be 0 or 1"));
-  DEFINE_STATIC_LOCAL(String, failure_reason_invalid_separator,
-                      ("expected semicolon"));
-  DEFINE_STATIC_LOCAL(String, failure_reason_invalid_equals,
-                      ("expected equals sign"));
-  DEFINE_STATIC_LOCAL(String, failure_reason_invalid_mode,
-                      ("invalid mode directive"));
-  DEFINE_STATIC_LOCAL(String, failure_reason_invalid_report,
-                      ("invalid report directive"));
-  DEFINE_STATIC_LOCAL(String, failure_reason_duplicate_mode,
-                      ("duplicate mode directive"));
-  DEFINE_STATIC_LOCAL(String, failure_reason_duplicate_report,
-                      ("duplicate report directive"));
-  DEFINE_STATIC_LOCAL(String, failure_reason_invalid_directive,
-                      ("unrecognized directive"));
+  static const char failure_reason_invalid_toggle[] =
+      "expected token to be 0 or 1";
+  static const char failure_reason_invalid_separator[] = "expected semicolon";
+  static const char failure_reason_invalid_equals[] = "expected equals sign";
+  static const char failure_reason_invalid_mode[] = "invalid mode directive";
+  static const char failure_reason_invalid_report[] =
+      "invalid report directive";
+  static const char failure_reason_duplicate_mode[] =
+      "duplicate mode directive";
+  static const char failure_reason_duplicate_report[] =
+      "duplicate report directive";
+  static const char failure_reason_invalid_directive[] =
+      "unrecognized directive";
 
   HeaderFieldTokenizer tokenizer(header);
 
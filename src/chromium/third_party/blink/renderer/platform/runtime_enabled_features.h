@@ -35,6 +35,7 @@ class RuntimeEnabledFeatures final
 public:
     BLINK_DEFINE_STABLE_FEATURE(CallCaptureListenersAtCapturePhaseAtShadowHosts)
     BLINK_DEFINE_STABLE_FEATURE(CSSInBodyDoesNotBlockPaint)
+    BLINK_DEFINE_STABLE_FEATURE(ThreadedHTMLParser)
     BLINK_DEFINE_STABLE_FEATURE(TrustedEventsDefaultAction)
 
     BLINK_DEFINE_EXPERIMENTAL_FEATURE(CSSFocusVisible)
@@ -35,7 +35,7 @@ void TimerBase::RunInternal(void)
     m_isActive = false;
 
 #if DCHECK_IS_ON()
-    ASSERT(CurrentThread() == m_thread);
+    ASSERT(IsCurrentThread(m_thread));
 #endif
 
     if (!m_repeatInterval.is_zero())
@@ -58,7 +58,7 @@ void TimerBase::RunInternal(void)
 void TimerBase::Start(TimeDelta nextFireInterval, TimeDelta repeatInterval, const base::Location &caller)
 {
 #if DCHECK_IS_ON()
-    ASSERT(CurrentThread() == m_thread);
+    ASSERT(IsCurrentThread(m_thread));
 #endif
 
     m_location = caller;
@@ -69,7 +69,7 @@ void TimerBase::Start(TimeDelta nextFireInterval, TimeDelta repeatInterval, cons
 void TimerBase::SetNextFireTime(TimeTicks now, TimeDelta delay)
 {
 #if DCHECK_IS_ON()
-    ASSERT(CurrentThread() == m_thread);
+    ASSERT(IsCurrentThread(m_thread));
 #endif
 
     TimeTicks newTime = now + delay;
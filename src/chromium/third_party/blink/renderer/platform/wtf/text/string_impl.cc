@@ -137,7 +137,8 @@ scoped_refptr<StringImpl> StringImpl::CreateUninitialized(wtf_size_t length,
 }
 
 static StaticStringsTable& StaticStrings() {
-  DEFINE_STATIC_LOCAL(StaticStringsTable, static_strings, ());
+  // Filled on the initializing thread, then read by every engine thread.
+  DEFINE_THREAD_SAFE_STATIC_LOCAL(StaticStringsTable, static_strings, ());
   return static_strings;
 }
 
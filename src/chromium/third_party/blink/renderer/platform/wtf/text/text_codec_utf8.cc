@@ -26,13 +26,31 @@
 #include "third_party/blink/renderer/platform/wtf/text/text_codec_utf8.h"
 
 #include <memory>
+#include "base/compiler_specific.h"
 #include "base/memory/ptr_util.h"
 #include "base/numerics/checked_math.h"
+#include "build/build_config.h"
 #include "third_party/blink/renderer/platform/wtf/text/character_names.h"
 #include "third_party/blink/renderer/platform/wtf/text/cstring.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_buffer.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_codec_ascii_fast_path.h"
 
+#if defined(ARCH_CPU_X86_64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WTF_UTF8_USE_SSE2 1
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#define WTF_UTF8_TARGET_SSSE3
+#else
+#include <cpuid.h>
+#define WTF_UTF8_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#else
+#define WTF_UTF8_USE_SSE2 0
+#endif
+
 namespace WTF {
 
 // We'll use nonCharacter* constants to signal invalid utf-8.
@@ -145,6 +163,328 @@ static inline int DecodeNonASCIISequence(const uint8_t* sequence,
          0x03C82080;
 }
 
+#if WTF_UTF8_USE_SSE2
+
+// The SIMD path validates 16 input bytes at a time and transcodes only the
+// complete sequences of blocks that are known to be well-formed. Anything
+// else (errors, sequences crossing the end of the input) is left to the
+// scalar decoder below, so error replacement behaves exactly as before.
+//
+// Transcoding reads up to 2 bytes past the block, and may write up to 16
+// code units from the current destination, hence the extra input slack.
+const ptrdiff_t kSIMDBlockSize = 16;
+const ptrdiff_t kSIMDInputSize = kSIMDBlockSize + 2;
+
+struct UTF8Block {
+  // Number of bytes at the start of the block which form complete sequences.
+  // Zero if the block contains malformed input.
+  unsigned length;
+  // One bit for the first byte of each sequence in [0, length).
+  unsigned starts;
+  bool all_ascii;
+  // True if every code point in [0, length) is in the Latin-1 range.
+  bool latin1;
+  // True if there are 4-byte sequences, i.e. surrogate pairs in UTF-16.
+  bool supplementary;
+};
+
+static inline unsigned ByteMask(__m128i bytes) {
+  return static_cast<unsigned>(_mm_movemask_epi8(bytes));
+}
+
+// Mask of bytes in [lo, hi], where 0x80 <= lo <= hi < 0xFF. Such bytes are
+// negative as signed chars, so signed compares keep their order.
+static inline unsigned RangeMask(__m128i v, uint8_t lo, uint8_t hi) {
+  __m128i below = _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1)));
+  if (lo == 0x80)
+    return ByteMask(below);
+  __m128i above = _mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1)));
+  return ByteMask(_mm_and_si128(above, below));
+}
+
+static inline unsigned EqualMask(__m128i v, uint8_t b) {
+  return ByteMask(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(b))));
+}
+
+static inline unsigned LowestBitIndex(unsigned mask) {
+  DCHECK(mask);
+#if defined(COMPILER_MSVC)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+static bool CPUSupportsSSSE3() {
+#if defined(COMPILER_MSVC)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 9)) != 0;
+#else
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return false;
+  return (ecx & bit_SSSE3) != 0;
+#endif
+}
+
+static ALWAYS_INLINE UTF8Block ClassifyBlock(const uint8_t* source) {
+  UTF8Block block = {0, 0, false, false, false};
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+
+  unsigned non_ascii = ByteMask(v);
+  if (!non_ascii) {
+    block.length = kSIMDBlockSize;
+    block.all_ascii = block.latin1 = true;
+    return block;
+  }
+
+  // Stop before the first sequence which does not fit into this block. This
+  // only looks at the tail bytes, so the position of the next block does not
+  // depend on the rest of the classification.
+  unsigned length = kSIMDBlockSize;
+  if (source[13] >= 0xF0)
+    length = 13;
+  else if (source[14] >= 0xE0)
+    length = 14;
+  else if (source[15] >= 0xC0)
+    length = 15;
+  const unsigned window = (1u << length) - 1;
+
+  unsigned cont = RangeMask(v, 0x80, 0xBF);
+  unsigned lead2 = RangeMask(v, 0xC2, 0xDF);
+  unsigned lead3 = RangeMask(v, 0xE0, 0xEF);
+  unsigned lead4 = RangeMask(v, 0xF0, 0xF4);
+  // 0xC0, 0xC1 and 0xF5..0xFF can never appear in UTF-8.
+  if (non_ascii & ~(cont | lead2 | lead3 | lead4))
+    return block;
+  lead2 &= window;
+  lead3 &= window;
+  lead4 &= window;
+
+  // Every continuation byte must be claimed by exactly one lead byte.
+  unsigned expected = ((lead2 | lead3 | lead4) << 1) |
+                      ((lead3 | lead4) << 2) | (lead4 << 3);
+  if (expected != (cont & window))
+    return block;
+
+  // Overlong and surrogate forms, same rules as DecodeNonASCIISequence.
+  if (lead3 | lead4) {
+    unsigned cont_80_9f = RangeMask(v, 0x80, 0x9F);
+    unsigned cont_80_8f = RangeMask(v, 0x80, 0x8F);
+    if (((EqualMask(v, 0xE0) & lead3) << 1) & cont_80_9f)
+      return block;
+    if (((EqualMask(v, 0xED) & lead3) << 1) & (cont & ~cont_80_9f))
+      return block;
+    if (((EqualMask(v, 0xF0) & lead4) << 1) & cont_80_8f)
+      return block;
+    if (((EqualMask(v, 0xF4) & lead4) << 1) & (cont & ~cont_80_8f))
+      return block;
+  }
+
+  block.length = length;
+  block.starts = (~non_ascii | lead2 | lead3 | lead4) & window;
+  block.latin1 =
+      !lead3 && !lead4 && lead2 == (RangeMask(v, 0xC2, 0xC3) & window);
+  block.supplementary = lead4 != 0;
+  return block;
+}
+
+static inline void CopyASCIIBlock(LChar* destination, const uint8_t* source) {
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i*>(destination),
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+}
+
+static inline void CopyASCIIBlock(UChar* destination, const uint8_t* source) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+  __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),
+                   _mm_unpacklo_epi8(v, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 8),
+                   _mm_unpackhi_epi8(v, zero));
+}
+
+// Copies as many whole ASCII blocks as possible.
+template <typename CharType>
+static inline void CopyASCIIBlocks(CharType*& destination,
+                                   const uint8_t*& source,
+                                   const uint8_t* end) {
+  while (end - source >= kSIMDBlockSize) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    if (_mm_movemask_epi8(v))
+      break;
+    CopyASCIIBlock(destination, source);
+    source += kSIMDBlockSize;
+    destination += kSIMDBlockSize;
+  }
+}
+
+// Decodes a BMP code point as if a 1, 2 or 3-byte sequence started at each
+// of 8 positions. |b0|, |b1| and |b2| hold the bytes at offsets 0, 1 and 2
+// from those positions, zero-extended to 16 bits.
+static inline __m128i DecodeBMPCandidates(__m128i b0, __m128i b1, __m128i b2) {
+  const __m128i low6 = _mm_set1_epi16(0x3F);
+  __m128i t1 = _mm_slli_epi16(_mm_and_si128(b1, low6), 6);
+  __m128i t2 = _mm_and_si128(b2, low6);
+  __m128i two = _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(b0, _mm_set1_epi16(0x1F)), 6),
+      _mm_and_si128(b1, low6));
+  __m128i three = _mm_or_si128(_mm_slli_epi16(b0, 12), _mm_or_si128(t1, t2));
+
+  __m128i is_ascii = _mm_cmplt_epi16(b0, _mm_set1_epi16(0x80));
+  __m128i is_three = _mm_cmpgt_epi16(b0, _mm_set1_epi16(0xDF));
+  __m128i multi = _mm_or_si128(_mm_and_si128(is_three, three),
+                               _mm_andnot_si128(is_three, two));
+  return _mm_or_si128(_mm_and_si128(is_ascii, b0),
+                      _mm_andnot_si128(is_ascii, multi));
+}
+
+static ALWAYS_INLINE void DecodeBMPCandidates(const uint8_t* source,
+                                       __m128i& low,
+                                       __m128i& high) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+  __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 1));
+  __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 2));
+  low = DecodeBMPCandidates(_mm_unpacklo_epi8(v0, zero),
+                            _mm_unpacklo_epi8(v1, zero),
+                            _mm_unpacklo_epi8(v2, zero));
+  high = DecodeBMPCandidates(_mm_unpackhi_epi8(v0, zero),
+                             _mm_unpackhi_epi8(v1, zero),
+                             _mm_unpackhi_epi8(v2, zero));
+}
+
+// PSHUFB masks which move the lanes selected by an 8-bit mask to the front,
+// for 16-bit and 8-bit lanes, and the number of selected lanes.
+struct CompactionTable {
+  uint8_t shuffle16[256][16];
+  uint8_t shuffle8[256][16];
+  uint8_t count[256];
+};
+
+static constexpr CompactionTable BuildCompactionTable() {
+  CompactionTable table = {};
+  for (unsigned mask = 0; mask < 256; ++mask) {
+    unsigned n = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+      if (!(mask & (1u << i)))
+        continue;
+      table.shuffle16[mask][2 * n] = 2 * i;
+      table.shuffle16[mask][2 * n + 1] = 2 * i + 1;
+      table.shuffle8[mask][n] = i;
+      ++n;
+    }
+    for (unsigned i = 2 * n; i < 16; ++i)
+      table.shuffle16[mask][i] = 0x80;
+    for (unsigned i = n; i < 16; ++i)
+      table.shuffle8[mask][i] = 0x80;
+    table.count[mask] = n;
+  }
+  return table;
+}
+
+static constexpr CompactionTable kCompactionTable = BuildCompactionTable();
+
+static inline __m128i LoadShuffle(const uint8_t* mask) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+WTF_UTF8_TARGET_SSSE3 static void CompactCandidatesSSSE3(LChar*& destination,
+                                                         __m128i candidates,
+                                                         unsigned starts) {
+  unsigned low = starts & 0xFF, high = starts >> 8;
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(destination),
+                   _mm_shuffle_epi8(candidates, LoadShuffle(
+                       kCompactionTable.shuffle8[low])));
+  destination += kCompactionTable.count[low];
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(destination),
+                   _mm_shuffle_epi8(_mm_srli_si128(candidates, 8), LoadShuffle(
+                       kCompactionTable.shuffle8[high])));
+  destination += kCompactionTable.count[high];
+}
+
+WTF_UTF8_TARGET_SSSE3 static void CompactCandidatesSSSE3(UChar*& destination,
+                                                         __m128i low_candidates,
+                                                         __m128i high_candidates,
+                                                         unsigned starts) {
+  unsigned low = starts & 0xFF, high = starts >> 8;
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),
+                   _mm_shuffle_epi8(low_candidates, LoadShuffle(
+                       kCompactionTable.shuffle16[low])));
+  destination += kCompactionTable.count[low];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),
+                   _mm_shuffle_epi8(high_candidates, LoadShuffle(
+                       kCompactionTable.shuffle16[high])));
+  destination += kCompactionTable.count[high];
+}
+
+// Transcodes input which ClassifyBlock() has already validated. Candidates
+// are computed for every byte, then the ones at sequence starts are kept.
+static ALWAYS_INLINE void TranscodeValidatedBlock(LChar*& destination,
+                                           const uint8_t* source,
+                                           const UTF8Block& block,
+                                           bool ssse3) {
+  DCHECK(block.latin1);
+  __m128i low, high;
+  DecodeBMPCandidates(source, low, high);
+  __m128i candidates = _mm_packus_epi16(low, high);
+  if (ssse3) {
+    CompactCandidatesSSSE3(destination, candidates, block.starts);
+    return;
+  }
+  LChar buffer[kSIMDBlockSize];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), candidates);
+  for (unsigned starts = block.starts; starts; starts &= starts - 1)
+    *destination++ = buffer[LowestBitIndex(starts)];
+}
+
+static ALWAYS_INLINE void TranscodeValidatedBlock(UChar*& destination,
+                                           const uint8_t* source,
+                                           const UTF8Block& block,
+                                           bool ssse3) {
+  if (block.supplementary) {
+    const uint8_t* end = source + block.length;
+    while (source < end) {
+      uint8_t b = *source;
+      if (IsASCII(b)) {
+        *destination++ = b;
+        ++source;
+      } else if (b < 0xE0) {
+        *destination++ = ((b & 0x1F) << 6) | (source[1] & 0x3F);
+        source += 2;
+      } else if (b < 0xF0) {
+        *destination++ = ((b & 0x0F) << 12) | ((source[1] & 0x3F) << 6) |
+                         (source[2] & 0x3F);
+        source += 3;
+      } else {
+        UChar32 character = ((b & 0x07) << 18) | ((source[1] & 0x3F) << 12) |
+                            ((source[2] & 0x3F) << 6) | (source[3] & 0x3F);
+        *destination++ = U16_LEAD(character);
+        *destination++ = U16_TRAIL(character);
+        source += 4;
+      }
+    }
+    return;
+  }
+
+  __m128i low, high;
+  DecodeBMPCandidates(source, low, high);
+  if (ssse3) {
+    CompactCandidatesSSSE3(destination, low, high, block.starts);
+    return;
+  }
+  UChar buffer[kSIMDBlockSize];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), low);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + 8), high);
+  for (unsigned starts = block.starts; starts; starts &= starts - 1)
+    *destination++ = buffer[LowestBitIndex(starts)];
+}
+
+#endif  // WTF_UTF8_USE_SSE2
+
 static inline UChar* AppendCharacter(UChar* destination, int character) {
   DCHECK(!IsNonCharacter(character));
   DCHECK(!U_IS_SURROGATE(character));
@@ -302,6 +642,10 @@ String TextCodecUTF8::Decode(const char* bytes,
   const uint8_t* end = source + length;
   const uint8_t* aligned_end = AlignToMachineWord(end);
   LChar* destination = buffer.Characters();
+#if WTF_UTF8_USE_SSE2
+  static const bool ssse3 = CPUSupportsSSSE3();
+  const uint8_t* scalar_until = source;
+#endif
 
   do {
     if (partial_sequence_size_) {
@@ -323,6 +667,24 @@ String TextCodecUTF8::Decode(const char* bytes,
     }
 
     while (source < end) {
+#if WTF_UTF8_USE_SSE2
+      if (source >= scalar_until && end - source >= kSIMDInputSize) {
+        UTF8Block block = ClassifyBlock(source);
+        if (block.all_ascii) {
+          CopyASCIIBlocks(destination, source, end);
+          continue;
+        }
+        if (block.length) {
+          if (!block.latin1)
+            goto upConvertTo16Bit;
+          TranscodeValidatedBlock(destination, source, block, ssse3);
+          source += block.length;
+          continue;
+        }
+        // Malformed input, let the scalar code below report it.
+        scalar_until = source + kSIMDBlockSize;
+      }
+#endif
       if (IsASCII(*source)) {
         // Fast path for ASCII. Most UTF-8 text will be ASCII.
         if (IsAlignedToMachineWord(source)) {
@@ -405,6 +767,22 @@ upConvertTo16Bit:
     }
 
     while (source < end) {
+#if WTF_UTF8_USE_SSE2
+      if (source >= scalar_until && end - source >= kSIMDInputSize) {
+        UTF8Block block = ClassifyBlock(source);
+        if (block.all_ascii) {
+          CopyASCIIBlocks(destination16, source, end);
+          continue;
+        }
+        if (block.length) {
+          TranscodeValidatedBlock(destination16, source, block, ssse3);
+          source += block.length;
+          continue;
+        }
+        // Malformed input, let the scalar code below report it.
+        scalar_until = source + kSIMDBlockSize;
+      }
+#endif
       if (IsASCII(*source)) {
         // Fast path for ASCII. Most UTF-8 text will be ASCII.
         if (IsAlignedToMachineWord(source)) {
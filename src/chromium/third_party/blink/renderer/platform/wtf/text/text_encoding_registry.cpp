@@ -106,11 +106,10 @@ const char* AtomicCanonicalTextEncodingName(const char *name)
     if (nullptr == name || '\0' == *name)
         return nullptr;
 
-    if (g_textEncodingNameMap.empty())
-        BuildBaseTextCodecMaps();
-
     std::string lower = base::ToLowerASCII(name);
     std::lock_guard<std::mutex> lock(g_registryMutex);
+    if (g_textEncodingNameMap.empty())
+        BuildBaseTextCodecMaps();
     auto it = g_textEncodingNameMap.find(lower);
     do {
         if (std::end(g_textEncodingNameMap) != it || g_textCodecMapsExtended)
@@ -79,7 +79,7 @@ class ThreadRestrictionVerifier {
 
   // Is it OK to use the object at this moment on the current thread?
   bool IsSafeToUse() const {
-    return !shared_ || owning_thread_ == CurrentThread();
+    return !shared_ || IsCurrentThread(owning_thread_);
   }
 
  private:
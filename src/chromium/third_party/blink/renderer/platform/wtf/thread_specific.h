@@ -97,7 +97,7 @@ inline void ThreadSpecific<T>::Destroy(void* ptr) {
   // longer has a graceful shutdown sequence. Be careful to call this function
   // (which can be re-entrant) while the pointer is still set, to avoid lazily
   // allocating WTFThreadData after it is destroyed.
-  if (IsMainThread())
+  if (IsInitializingThread())
     return;
 
   // The memory was allocated via Partitions::FastZeroedMalloc, and then the
@@ -125,7 +125,7 @@ inline ThreadSpecific<T>::operator T*() {
 #else
   const bool kMainThreadAlwaysChecksTLS = false;
   T** ptr = &main_thread_storage_;
-  if (UNLIKELY(!IsMainThread())) {
+  if (UNLIKELY(!IsInitializingThread())) {
     off_thread_ptr = static_cast<T*>(Get());
     ptr = &off_thread_ptr;
   }
@@ -140,7 +140,7 @@ inline ThreadSpecific<T>::operator T*() {
     // Even if we didn't realize we're on the main thread, we might still be.
     // We need to double-check so that |main_thread_storage_| is populated.
     if (!kMainThreadAlwaysChecksTLS && UNLIKELY(ptr != &main_thread_storage_) &&
-        IsMainThread()) {
+        IsInitializingThread()) {
       main_thread_storage_ = *ptr;
     }
 
@@ -47,6 +47,9 @@ ThreadIdentifier CurrentThreadSyscall() {
 
 namespace {
 bool g_current_thread_key_initialized = false;
+// Identifiers of the forking thread before & after the last fork, in a child.
+ThreadIdentifier g_thread_before_fork = 0;
+ThreadIdentifier g_thread_after_fork = 0;
 
 #if defined(OS_WIN)
 DWORD g_current_thread_key;
@@ -103,6 +106,20 @@ ThreadIdentifier CurrentThread() {
   return reinterpret_cast<ThreadIdentifier>(value);
 }
 
+void RenewCurrentThreadAfterFork() {
+  g_thread_before_fork = CurrentThread();
+  RawCurrentThreadSet(nullptr);
+  g_thread_after_fork = CurrentThread();
+}
+
+bool IsCurrentThread(ThreadIdentifier thread) {
+  const ThreadIdentifier current = CurrentThread();
+  if (thread == current)
+    return true;
+  return 0 != g_thread_before_fork && thread == g_thread_before_fork &&
+         current == g_thread_after_fork;
+}
+
 // For debugging only -- whether a non-main thread has been created.
 // No synchronization is required, since this is called before any such thread
 // exists.
@@ -55,6 +55,14 @@ WTF_EXPORT void InitializeCurrentThread();
 
 WTF_EXPORT ThreadIdentifier CurrentThread();
 
+// Renews the identifier of the current thread in a forked child, where the
+// thread has got a new one.
+WTF_EXPORT void RenewCurrentThreadAfterFork();
+// Whether |thread| is the current thread. Unlike comparing it with
+// CurrentThread(), this also accepts the identifier the forking thread had
+// before the fork, which objects created in the parent have recorded.
+WTF_EXPORT bool IsCurrentThread(ThreadIdentifier thread);
+
 #if DCHECK_IS_ON()
 WTF_EXPORT bool IsBeforeThreadCreated();
 WTF_EXPORT void WillCreateThread();
@@ -64,5 +72,6 @@ WTF_EXPORT void WillCreateThread();
 
 using WTF::ThreadIdentifier;
 using WTF::CurrentThread;
+using WTF::IsCurrentThread;
 
 #endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_THREADING_H_
@@ -21,6 +21,7 @@ namespace WTF {
 static bool g_initialized = false;
 static void (*g_callOnMainThreadFunction)(MainThreadFunction, void *) = nullptr;
 static ThreadIdentifier g_mainThreadIdentifier;
+static thread_local bool t_isEngineThread = false;
 
 namespace internal {
 
@@ -32,10 +33,31 @@ void CallOnMainThread(MainThreadFunction *function, void *context)
 }  // namespace internal
 
 bool IsMainThread(void)
+{
+    return t_isEngineThread || IsInitializingThread();
+}
+
+bool IsInitializingThread(void)
 {
     return CurrentThread() == g_mainThreadIdentifier;
 }
 
+void InitializeEngineThread(void)
+{
+    ASSERT(g_initialized);
+    ASSERT(!IsInitializingThread());
+    t_isEngineThread = true;
+}
+
+void ResumeAfterFork(void)
+{
+    ASSERT(g_initialized);
+    ASSERT(IsInitializingThread());
+    // The forking thread goes on as the main thread of the child, under a new identifier.
+    RenewCurrentThreadAfterFork();
+    g_mainThreadIdentifier = CurrentThread();
+}
+
 void Initialize(void (*callOnMainThreadFunction)(MainThreadFunction, void *))
 {
     // WTF, and Blink in general, cannot handle being re-initialized.
@@ -41,7 +41,16 @@ typedef void MainThreadFunction(void*);
 // This function must be called exactly once from the main thread before using
 // anything else in WTF.
 WTF_EXPORT void Initialize(void (*)(MainThreadFunction, void*));
+// Marks the current thread as an engine thread of the pool mode, which runs
+// blink on its own and is considered as a main thread from then on.
+WTF_EXPORT void InitializeEngineThread();
+// Re-registers the main thread in a forked child, which must be forked by the
+// thread which called Initialize.
+WTF_EXPORT void ResumeAfterFork();
 WTF_EXPORT bool IsMainThread();
+// The thread which called Initialize. Unlike IsMainThread, this is false on
+// the engine threads.
+WTF_EXPORT bool IsInitializingThread();
 
 namespace internal {
 void CallOnMainThread(MainThreadFunction*, void* context);
@@ -49,6 +58,7 @@ void CallOnMainThread(MainThreadFunction*, void* context);
 
 }  // namespace WTF
 
+using WTF::IsInitializingThread;
 using WTF::IsMainThread;
 
 #endif  // THIRD_PARTY_BLINK_RENDERER_PLATFORM_WTF_WTF_H_